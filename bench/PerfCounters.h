@@ -0,0 +1,101 @@
+#ifndef PERF_COUNTERS_H
+#define PERF_COUNTERS_H
+
+#include <cstdint>
+#include <cstring>
+
+#ifdef __linux__
+#include <linux/perf_event.h>
+#include <sys/ioctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+#endif
+
+
+// Аппаратные счётчики через perf_event_open (только Linux).
+// Если счётчик недоступен (нет прав, виртуальная машина, другая ОС),
+// available() возвращает false, а значения остаются нулевыми.
+class PerfCounters {
+   public:
+    struct Values {
+        uint64_t cycles = 0;
+        uint64_t cache_misses = 0;
+        uint64_t branch_misses = 0;
+    };
+
+   private:
+    int fds_[3] = {-1, -1, -1};
+
+#ifdef __linux__
+    static int open_counter(uint64_t config, int group_fd) {
+        perf_event_attr attr;
+        std::memset(&attr, 0, sizeof(attr));
+        attr.type = PERF_TYPE_HARDWARE;
+        attr.size = sizeof(attr);
+        attr.config = config;
+        attr.disabled = group_fd == -1 ? 1 : 0;
+        attr.exclude_kernel = 1;
+        attr.exclude_hv = 1;
+        return static_cast<int>(
+            syscall(SYS_perf_event_open, &attr, 0, -1, group_fd, 0));
+    }
+
+    static uint64_t read_counter(int fd) {
+        uint64_t value = 0;
+        if (fd < 0 || ::read(fd, &value, sizeof(value)) != sizeof(value)) {
+            return 0;
+        }
+        return value;
+    }
+#endif
+
+   public:
+    PerfCounters() {
+#ifdef __linux__
+        fds_[0] = open_counter(PERF_COUNT_HW_CPU_CYCLES, -1);
+        if (fds_[0] >= 0) {
+            fds_[1] = open_counter(PERF_COUNT_HW_CACHE_MISSES, fds_[0]);
+            fds_[2] = open_counter(PERF_COUNT_HW_BRANCH_MISSES, fds_[0]);
+        }
+#endif
+    }
+
+    ~PerfCounters() {
+#ifdef __linux__
+        for (int fd : fds_) {
+            if (fd >= 0) {
+                close(fd);
+            }
+        }
+#endif
+    }
+
+    PerfCounters(const PerfCounters&) = delete;
+    PerfCounters& operator=(const PerfCounters&) = delete;
+
+    bool available() const { return fds_[0] >= 0; }
+
+    void start() {
+#ifdef __linux__
+        if (available()) {
+            ioctl(fds_[0], PERF_EVENT_IOC_RESET, PERF_IOC_FLAG_GROUP);
+            ioctl(fds_[0], PERF_EVENT_IOC_ENABLE, PERF_IOC_FLAG_GROUP);
+        }
+#endif
+    }
+
+    Values stop() {
+        Values values;
+#ifdef __linux__
+        if (available()) {
+            ioctl(fds_[0], PERF_EVENT_IOC_DISABLE, PERF_IOC_FLAG_GROUP);
+            values.cycles = read_counter(fds_[0]);
+            values.cache_misses = read_counter(fds_[1]);
+            values.branch_misses = read_counter(fds_[2]);
+        }
+#endif
+        return values;
+    }
+};
+
+#endif
@@ -0,0 +1,97 @@
+#include <chrono>
+#include <cstring>
+#include <iostream>
+
+#include "FixedBlockMapResource.h"
+#include "ForwardList.h"
+#include "PerfCounters.h"
+
+
+// Операции списка и ресурса с замером времени и (с флагом --perf)
+// аппаратных счётчиков. Цель lab_05_bench_alloc_traced собрана
+// с LAB05_ENABLE_TRACING - сравнение двух целей показывает цену хуков.
+
+constexpr int kElements = 100000;
+
+template <typename Func>
+void measure(const char* name, bool use_perf, Func func) {
+    PerfCounters counters;
+    if (use_perf) {
+        counters.start();
+    }
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto finish = std::chrono::steady_clock::now();
+    PerfCounters::Values values = use_perf ? counters.stop()
+                                           : PerfCounters::Values{};
+
+    double ns = std::chrono::duration<double, std::nano>(finish - start)
+                    .count();
+    std::cout << name << ": " << ns / kElements << " нс/операция";
+    if (use_perf) {
+        if (counters.available()) {
+            std::cout << ", циклов " << values.cycles / kElements
+                      << ", cache-miss " << values.cache_misses
+                      << ", branch-miss " << values.branch_misses;
+        } else {
+            std::cout << " (perf_event_open недоступен)";
+        }
+    }
+    std::cout << "\n";
+}
+
+int main(int argc, char** argv) {
+    bool use_perf = argc > 1 && std::strcmp(argv[1], "--perf") == 0;
+
+#ifdef LAB05_ENABLE_TRACING
+    std::cout << "Трассировка включена (1 замер на 1024 операции)\n";
+    AllocationTracer tracer;
+#endif
+
+    FixedBlockMapResource resource(16 * 1024 * 1024);
+#ifdef LAB05_ENABLE_TRACING
+    resource.set_tracer(&tracer);
+#endif
+
+    {
+        ForwardList<int> list(&resource);
+        measure("push_front", use_perf, [&] {
+            for (int i = 0; i < kElements; ++i) {
+                list.push_front(i);
+            }
+        });
+        measure("pop_front", use_perf, [&] {
+            for (int i = 0; i < kElements; ++i) {
+                list.pop_front();
+            }
+        });
+        measure("push_front (повторное использование)", use_perf, [&] {
+            for (int i = 0; i < kElements; ++i) {
+                list.push_front(i);
+            }
+        });
+        measure("clear", use_perf, [&] { list.clear(); });
+    }
+
+    measure("allocate+deallocate", use_perf, [&] {
+        for (int i = 0; i < kElements; ++i) {
+            void* ptr = resource.allocate(32, 8);
+            resource.deallocate(ptr, 32, 8);
+        }
+    });
+
+#ifdef LAB05_ENABLE_TRACING
+    AllocationSample sample;
+    uint64_t count = 0;
+    uint64_t slowest = 0;
+    while (tracer.samples().pop(sample)) {
+        ++count;
+        if (sample.nanoseconds > slowest) {
+            slowest = sample.nanoseconds;
+        }
+    }
+    std::cout << "Замеров: " << count << ", самый долгий: " << slowest
+              << " нс, отброшено: " << tracer.samples().dropped() << "\n";
+#endif
+    return 0;
+}
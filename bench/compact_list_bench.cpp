@@ -0,0 +1,101 @@
+#include <chrono>
+#include <iostream>
+
+#ifdef __GLIBC__
+#include <malloc.h>
+#endif
+
+#include "CompactForwardList.h"
+#include "FixedBlockMapResource.h"
+#include "ForwardList.h"
+
+
+// Байты на элемент и скорость обхода: ForwardList<int> (указатели)
+// против CompactForwardList<int> (32-битные смещения).
+//
+// Байты измеряются: занятая часть буфера ресурса плюс прирост глобальной
+// кучи за время заполнения - там живут записи std::map, которыми
+// FixedBlockMapResource учитывает каждый узел (только glibc, mallinfo2).
+
+constexpr int kTraversals = 20;
+
+volatile long long g_sink = 0;
+
+// Байты глобальной кучи, занятые сейчас (0, если узнать нельзя)
+size_t heap_in_use() {
+#ifdef __GLIBC__
+    struct mallinfo2 info = mallinfo2();
+    return info.uordblks + info.hblkhd;
+#else
+    return 0;
+#endif
+}
+
+struct Footprint {
+    double buffer_per_element;
+    double bookkeeping_per_element;
+};
+
+// Заполнить список и измерить, сколько памяти ушло на элемент
+template <typename List>
+Footprint fill(List& list, const FixedBlockMapResource& resource,
+               size_t elements) {
+    size_t heap_before = heap_in_use();
+    for (size_t i = 0; i < elements; ++i) {
+        list.push_back(static_cast<int>(i));
+    }
+    size_t heap_after = heap_in_use();
+    double n = static_cast<double>(elements);
+    return Footprint{resource.high_water_mark() / n,
+                     (heap_after - heap_before) / n};
+}
+
+template <typename List>
+double traverse_ns_per_element(List& list, size_t elements) {
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < kTraversals; ++r) {
+        long long sum = 0;
+        for (int value : list) {
+            sum += value;
+        }
+        g_sink = sum;
+    }
+    auto finish = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(finish - start).count() /
+           (static_cast<double>(elements) * kTraversals);
+}
+
+int main() {
+    std::cout << "Байт на узел: ForwardList<int> "
+              << sizeof(ForwardListNode<int>) << ", CompactForwardList<int> "
+              << CompactForwardList<int>::node_size() << "\n";
+
+    for (size_t elements : {4096, 262144, 4194304}) {
+        double pointer_ns;
+        Footprint pointer;
+        {
+            FixedBlockMapResource resource(elements * 16 + 64);
+            ForwardList<int> list(&resource);
+            pointer = fill(list, resource, elements);
+            pointer_ns = traverse_ns_per_element(list, elements);
+        }
+
+        double compact_ns;
+        Footprint compact;
+        {
+            FixedBlockMapResource resource(elements * 8 + 64);
+            CompactForwardList<int> list(resource);
+            compact = fill(list, resource, elements);
+            compact_ns = traverse_ns_per_element(list, elements);
+        }
+
+        std::cout << "n=" << elements << "\n  указатели: буфер "
+                  << pointer.buffer_per_element << " + учёт "
+                  << pointer.bookkeeping_per_element << " байт/элемент, "
+                  << pointer_ns << " нс/элемент\n  сжатые:    буфер "
+                  << compact.buffer_per_element << " + учёт "
+                  << compact.bookkeeping_per_element << " байт/элемент, "
+                  << compact_ns << " нс/элемент\n";
+    }
+    return 0;
+}
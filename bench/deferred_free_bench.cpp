@@ -0,0 +1,77 @@
+#include <algorithm>
+#include <chrono>
+#include <iostream>
+#include <vector>
+
+#include "DeferredFreeResource.h"
+#include "FixedBlockMapResource.h"
+#include "ForwardList.h"
+
+
+// Задержка "запроса", который строит список из 1M узлов и уничтожает его:
+// освобождение напрямую в FixedBlockMapResource против отложенного.
+// Замеряются уничтожение списка, весь запрос и самое долгое выделение
+// узла: при отложенном освобождении работа переезжает в выделения,
+// которые промахиваются мимо upstream, или в фоновый поток.
+
+constexpr int kNodes = 1000000;
+constexpr int kRequests = 20;
+constexpr size_t kBufferSize = size_t{3} * kNodes * 16;
+
+using Clock = std::chrono::steady_clock;
+
+double percentile(std::vector<double> values, double p) {
+    std::sort(values.begin(), values.end());
+    size_t index = static_cast<size_t>(p * (values.size() - 1) + 0.5);
+    return values[index];
+}
+
+double milliseconds(Clock::duration duration) {
+    return std::chrono::duration<double, std::milli>(duration).count();
+}
+
+void run(const char* name, std::pmr::memory_resource* resource) {
+    std::vector<double> drops;
+    std::vector<double> requests;
+    Clock::duration worst_allocation{};
+    for (int r = 0; r < kRequests; ++r) {
+        auto start = Clock::now();
+        auto* list = new ForwardList<int>(resource);
+        for (int i = 0; i < kNodes; ++i) {
+            auto before = Clock::now();
+            list->push_front(i);
+            worst_allocation = std::max(worst_allocation,
+                                        Clock::now() - before);
+        }
+        auto drop_start = Clock::now();
+        delete list;
+        auto finish = Clock::now();
+        drops.push_back(milliseconds(finish - drop_start));
+        requests.push_back(milliseconds(finish - start));
+    }
+    std::cout << name << ":\n  уничтожение списка p50 "
+              << percentile(drops, 0.5) << " мс, p99 "
+              << percentile(drops, 0.99) << " мс\n  весь запрос p50 "
+              << percentile(requests, 0.5) << " мс, p99 "
+              << percentile(requests, 0.99) << " мс, худшее выделение "
+              << milliseconds(worst_allocation) << " мс\n";
+}
+
+int main() {
+    {
+        FixedBlockMapResource upstream(kBufferSize);
+        run("без откладывания", &upstream);
+    }
+    {
+        FixedBlockMapResource upstream(kBufferSize);
+        DeferredFreeResource resource(&upstream);
+        run("отложенно (OnDemand)", &resource);
+    }
+    {
+        FixedBlockMapResource upstream(kBufferSize);
+        DeferredFreeResource resource(
+            &upstream, DeferredFreeResource::Reclaim::Background);
+        run("отложенно (Background)", &resource);
+    }
+    return 0;
+}
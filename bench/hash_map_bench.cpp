@@ -0,0 +1,81 @@
+#include <chrono>
+#include <iostream>
+#include <memory_resource>
+#include <unordered_map>
+
+#include "ChainedHashMap.h"
+#include "FixedBlockMapResource.h"
+
+
+// Сравнение ChainedHashMap и std::pmr::unordered_map на одном и том же
+// FixedBlockMapResource: вставка, поиск и удаление со вставкой (churn)
+
+constexpr int kElements = 100000;
+constexpr size_t kBufferSize = 64 * 1024 * 1024;
+
+template <typename Func>
+double measure_ms(Func func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto finish = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::milli>(finish - start).count();
+}
+
+void report(const char* container, const char* operation, double ms) {
+    std::cout << container << " " << operation << ": " << ms << " мс ("
+              << ms * 1e6 / kElements << " нс/операция)\n";
+}
+
+void bench_chained() {
+    FixedBlockMapResource resource(kBufferSize);
+    ChainedHashMap<int, int> map(&resource);
+    long long checksum = 0;
+
+    report("ChainedHashMap", "insert", measure_ms([&] {
+               for (int i = 0; i < kElements; ++i) {
+                   map.insert(i, i);
+               }
+           }));
+    report("ChainedHashMap", "find", measure_ms([&] {
+               for (int i = 0; i < kElements; ++i) {
+                   checksum += *map.find(i);
+               }
+           }));
+    report("ChainedHashMap", "erase+insert", measure_ms([&] {
+               for (int i = 0; i < kElements; ++i) {
+                   map.erase(i);
+                   map.insert(i + kElements, i);
+               }
+           }));
+    std::cout << "(checksum " << checksum << ")\n";
+}
+
+void bench_unordered() {
+    FixedBlockMapResource resource(kBufferSize);
+    std::pmr::unordered_map<int, int> map(&resource);
+    long long checksum = 0;
+
+    report("pmr::unordered_map", "insert", measure_ms([&] {
+               for (int i = 0; i < kElements; ++i) {
+                   map.emplace(i, i);
+               }
+           }));
+    report("pmr::unordered_map", "find", measure_ms([&] {
+               for (int i = 0; i < kElements; ++i) {
+                   checksum += map.find(i)->second;
+               }
+           }));
+    report("pmr::unordered_map", "erase+insert", measure_ms([&] {
+               for (int i = 0; i < kElements; ++i) {
+                   map.erase(i);
+                   map.emplace(i + kElements, i);
+               }
+           }));
+    std::cout << "(checksum " << checksum << ")\n";
+}
+
+int main() {
+    bench_chained();
+    bench_unordered();
+    return 0;
+}
@@ -0,0 +1,107 @@
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <iostream>
+#include <string>
+
+#include "FixedBlockMapResource.h"
+#include "ForwardList.h"
+#include "ForwardListIO.h"
+
+
+// Пропускная способность сериализации ForwardList<int> в файл и обратно.
+// Для списка над FixedBlockMapResource чтение сравнивается с поштучной
+// вставкой: deserialize берёт узлы пачками через allocate_bulk.
+
+constexpr int kElements = 16 * 1024 * 1024;
+constexpr int kResourceElements = 4 * 1024 * 1024;
+
+template <typename Func>
+double measure_seconds(Func func) {
+    auto start = std::chrono::steady_clock::now();
+    func();
+    auto finish = std::chrono::steady_clock::now();
+    return std::chrono::duration<double>(finish - start).count();
+}
+
+int main(int argc, char** argv) {
+    std::string path = argc > 1 ? argv[1] : "list_io_bench.bin";
+    double gigabytes = static_cast<double>(kElements) * sizeof(int) / 1e9;
+
+    ForwardList<int> list;
+    for (int i = 0; i < kElements; ++i) {
+        list.push_back(i);
+    }
+
+    double write_seconds = measure_seconds([&] {
+        std::ofstream out(path, std::ios::binary);
+        serialize(list, out);
+    });
+
+    ForwardList<int> restored;
+    double read_seconds = measure_seconds([&] {
+        std::ifstream in(path, std::ios::binary);
+        deserialize(in, restored);
+    });
+
+    long long sum = 0;
+    double stream_seconds = measure_seconds([&] {
+        std::ifstream in(path, std::ios::binary);
+        deserialize_batches<int>(in, [&sum](std::span<int> batch) {
+            for (int value : batch) {
+                sum += value;
+            }
+        });
+    });
+
+    // Список над FixedBlockMapResource: пачками против push_back
+    std::string small_path = path + ".small";
+    {
+        std::ofstream out(small_path, std::ios::binary);
+        ForwardList<int> small;
+        for (int i = 0; i < kResourceElements; ++i) {
+            small.push_back(i);
+        }
+        serialize(small, out);
+    }
+    double small_gigabytes =
+        static_cast<double>(kResourceElements) * sizeof(int) / 1e9;
+    size_t buffer_size = size_t{kResourceElements} * 16;
+    double bulk_seconds = 0;
+    {
+        FixedBlockMapResource resource(buffer_size);
+        ForwardList<int> target(&resource);
+        bulk_seconds = measure_seconds([&] {
+            std::ifstream in(small_path, std::ios::binary);
+            deserialize(in, target);
+        });
+    }
+    double single_seconds = 0;
+    {
+        FixedBlockMapResource resource(buffer_size);
+        ForwardList<int> target(&resource);
+        single_seconds = measure_seconds([&] {
+            std::ifstream in(small_path, std::ios::binary);
+            deserialize_batches<int>(in, [&target](std::span<int> batch) {
+                for (int value : batch) {
+                    target.push_back(value);
+                }
+            });
+        });
+    }
+    std::remove(small_path.c_str());
+
+    std::cout << "serialize:           " << gigabytes / write_seconds
+              << " ГБ/с\n";
+    std::cout << "deserialize в список: " << gigabytes / read_seconds
+              << " ГБ/с\n";
+    std::cout << "deserialize_batches:  " << gigabytes / stream_seconds
+              << " ГБ/с (сумма " << sum << ")\n";
+    std::cout << "FixedBlockMapResource, пачками:  "
+              << small_gigabytes / bulk_seconds << " ГБ/с\n";
+    std::cout << "FixedBlockMapResource, push_back: "
+              << small_gigabytes / single_seconds << " ГБ/с\n";
+
+    std::remove(path.c_str());
+    return restored.size() == list.size() ? 0 : 1;
+}
@@ -0,0 +1,109 @@
+#include <chrono>
+#include <deque>
+#include <iostream>
+#include <memory_resource>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+#include "MpscQueue.h"
+
+
+// MpscQueue против std::pmr::deque под мьютексом: N производителей,
+// один потребитель, всего kItems элементов
+
+constexpr int kItems = 1 << 20;
+
+// Очередь-эталон: deque, защищённая мьютексом
+class LockedDeque {
+   private:
+    std::mutex mutex_;
+    std::pmr::deque<int> items_;
+
+   public:
+    explicit LockedDeque(std::pmr::memory_resource* mr) : items_(mr) {}
+
+    void push(int value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        items_.push_back(value);
+    }
+
+    bool pop(int& value) {
+        std::lock_guard<std::mutex> lock(mutex_);
+        if (items_.empty()) {
+            return false;
+        }
+        value = items_.front();
+        items_.pop_front();
+        return true;
+    }
+};
+
+template <typename Push, typename Pop>
+double run(int producers, Push push, Pop pop) {
+    int per_producer = kItems / producers;
+    int total = per_producer * producers;
+
+    auto start = std::chrono::steady_clock::now();
+    std::vector<std::thread> threads;
+    for (int p = 0; p < producers; ++p) {
+        threads.emplace_back([&, p] {
+            for (int i = 0; i < per_producer; ++i) {
+                push(p * per_producer + i);
+            }
+        });
+    }
+
+    long long checksum = 0;
+    for (int received = 0; received < total;) {
+        int value;
+        if (pop(value)) {
+            checksum += value;
+            ++received;
+        }
+    }
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    auto finish = std::chrono::steady_clock::now();
+
+    if (checksum != static_cast<long long>(total) * (total - 1) / 2) {
+        std::cerr << "Ошибка: потеряны элементы\n";
+    }
+    return std::chrono::duration<double>(finish - start).count();
+}
+
+int main() {
+    for (int producers : {1, 2, 4, 8, 16, 32}) {
+        double mpsc_seconds;
+        {
+            std::pmr::synchronized_pool_resource resource;
+            MpscQueue<int> queue(&resource);
+            mpsc_seconds = run(
+                producers, [&](int v) { queue.push(v); },
+                [&](int& v) {
+                    auto item = queue.pop();
+                    if (!item) {
+                        return false;
+                    }
+                    v = *item;
+                    return true;
+                });
+        }
+
+        double deque_seconds;
+        {
+            std::pmr::synchronized_pool_resource resource;
+            LockedDeque queue(&resource);
+            deque_seconds = run(
+                producers, [&](int v) { queue.push(v); },
+                [&](int& v) { return queue.pop(v); });
+        }
+
+        std::cout << "производителей: " << producers
+                  << "  MpscQueue: " << kItems / mpsc_seconds / 1e6
+                  << " млн/с  mutex+deque: " << kItems / deque_seconds / 1e6
+                  << " млн/с\n";
+    }
+    return 0;
+}
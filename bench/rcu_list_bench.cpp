@@ -0,0 +1,114 @@
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <memory_resource>
+#include <mutex>
+#include <shared_mutex>
+#include <thread>
+#include <vector>
+
+#include "ForwardList.h"
+#include "RcuForwardList.h"
+
+
+// Пропускная способность читателей (полных обходов списка в секунду)
+// при непрерывной записи: RcuForwardList против ForwardList под
+// std::shared_mutex. Писатель всё время добавляет и удаляет голову.
+
+constexpr int kListSize = 1000;
+constexpr auto kDuration = std::chrono::milliseconds(300);
+
+template <typename ReadFn, typename WriteFn>
+double measure(int readers, ReadFn read, WriteFn write) {
+    std::atomic<bool> stop{false};
+    std::atomic<long long> traversals{0};
+    std::vector<std::thread> threads;
+    for (int r = 0; r < readers; ++r) {
+        threads.emplace_back([&] {
+            long long local = read(stop);
+            traversals.fetch_add(local);
+        });
+    }
+    std::thread writer([&] { write(stop); });
+
+    std::this_thread::sleep_for(kDuration);
+    stop.store(true);
+    for (auto& thread : threads) {
+        thread.join();
+    }
+    writer.join();
+    double seconds = std::chrono::duration<double>(kDuration).count();
+    return traversals.load() / seconds;
+}
+
+double run_rcu(int readers) {
+    std::pmr::unsynchronized_pool_resource pool;
+    RcuForwardList<int> list(&pool);
+    for (int i = 0; i < kListSize; ++i) {
+        list.push_front(i);
+    }
+    auto read = [&](std::atomic<bool>& stop) {
+        auto reader = list.register_reader();
+        long long count = 0;
+        long long sink = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            auto guard = reader.read();
+            for (int value : guard) {
+                sink += value;
+            }
+            ++count;
+        }
+        volatile long long keep = sink;
+        (void)keep;
+        return count;
+    };
+    auto write = [&](std::atomic<bool>& stop) {
+        for (int i = 0; !stop.load(std::memory_order_relaxed); ++i) {
+            list.push_front(i);
+            list.pop_front();
+        }
+    };
+    return measure(readers, read, write);
+}
+
+double run_shared_mutex(int readers) {
+    std::pmr::unsynchronized_pool_resource pool;
+    ForwardList<int> list(&pool);
+    std::shared_mutex mutex;
+    for (int i = 0; i < kListSize; ++i) {
+        list.push_front(i);
+    }
+    auto read = [&](std::atomic<bool>& stop) {
+        long long count = 0;
+        long long sink = 0;
+        while (!stop.load(std::memory_order_relaxed)) {
+            std::shared_lock<std::shared_mutex> lock(mutex);
+            for (int value : list) {
+                sink += value;
+            }
+            ++count;
+        }
+        volatile long long keep = sink;
+        (void)keep;
+        return count;
+    };
+    auto write = [&](std::atomic<bool>& stop) {
+        for (int i = 0; !stop.load(std::memory_order_relaxed); ++i) {
+            std::unique_lock<std::shared_mutex> lock(mutex);
+            list.push_front(i);
+            list.pop_front();
+        }
+    };
+    return measure(readers, read, write);
+}
+
+int main() {
+    std::cout << "читатели | RCU, обходов/с | shared_mutex, обходов/с\n";
+    for (int readers : {1, 2, 4, 8, 16, 32, 64}) {
+        double rcu = run_rcu(readers);
+        double locked = run_shared_mutex(readers);
+        std::cout << readers << " | " << static_cast<long long>(rcu) << " | "
+                  << static_cast<long long>(locked) << "\n";
+    }
+    return 0;
+}
@@ -0,0 +1,62 @@
+#include <chrono>
+#include <iostream>
+#include <numeric>
+
+#include "FixedBlockMapResource.h"
+#include "ForwardList.h"
+#include "ForwardListAlgorithms.h"
+
+
+// list_sum на разных уровнях SIMD против std::accumulate по итератору.
+// Размеры списка - от помещающихся в L1 до превышающих последний кэш.
+
+constexpr int kRepeatElements = 1 << 24;
+
+template <typename Func>
+double ns_per_element(size_t elements, Func func) {
+    int repeats = static_cast<int>(kRepeatElements / elements) + 1;
+    auto start = std::chrono::steady_clock::now();
+    for (int r = 0; r < repeats; ++r) {
+        func();
+    }
+    auto finish = std::chrono::steady_clock::now();
+    return std::chrono::duration<double, std::nano>(finish - start).count() /
+           (static_cast<double>(elements) * repeats);
+}
+
+template <typename T>
+void bench(const char* type_name, size_t elements) {
+    FixedBlockMapResource resource(elements * 32 + 4096);
+    ForwardList<T> list(&resource);
+    for (size_t i = 0; i < elements; ++i) {
+        list.push_back(static_cast<T>(i % 1000));
+    }
+
+    volatile ReduceSum<T> sink = 0;
+    double accumulate_ns = ns_per_element(elements, [&] {
+        sink = std::accumulate(list.begin(), list.end(), ReduceSum<T>(0));
+    });
+    double scalar_ns = ns_per_element(
+        elements, [&] { sink = list_sum(list, SimdLevel::Scalar); });
+    double sse_ns = ns_per_element(
+        elements, [&] { sink = list_sum(list, SimdLevel::Sse41); });
+    double avx_ns = ns_per_element(
+        elements, [&] { sink = list_sum(list, SimdLevel::Avx2); });
+
+    std::cout << type_name << " n=" << elements
+              << "  accumulate: " << accumulate_ns
+              << "  scalar: " << scalar_ns << "  sse4.1: " << sse_ns
+              << "  avx2: " << avx_ns << " нс/элемент\n";
+}
+
+int main() {
+    std::cout << "Уровень процессора: "
+              << static_cast<int>(detected_simd_level())
+              << " (0 - scalar, 1 - sse4.1, 2 - avx2)\n";
+    // ~1 КБ узлов (L1), ~256 КБ (L2), ~8 МБ (LLC), ~64 МБ (за LLC)
+    for (size_t elements : {64, 16384, 524288, 4194304}) {
+        bench<int>("int", elements);
+        bench<double>("double", elements);
+    }
+    return 0;
+}
@@ -0,0 +1,62 @@
+#include <chrono>
+#include <iostream>
+
+#include "FixedBlockMapResource.h"
+#include "ForwardList.h"
+
+
+// Создание и уничтожение ресурса на 1 КБ вместе с коротким списком:
+// буфер в куче, внешний буфер на стеке, буфер внутри объекта
+
+constexpr int kIterations = 200000;
+constexpr size_t kBufferSize = 1024;
+constexpr int kListSize = 8;
+
+template <typename Func>
+void measure(const char* name, Func func) {
+    auto start = std::chrono::steady_clock::now();
+    for (int i = 0; i < kIterations; ++i) {
+        func();
+    }
+    auto finish = std::chrono::steady_clock::now();
+    std::cout << name << ": "
+              << std::chrono::duration<double, std::nano>(finish - start)
+                         .count() /
+                     kIterations
+              << " нс на создание+уничтожение\n";
+}
+
+void fill(std::pmr::memory_resource* resource) {
+    ForwardList<int> list(resource);
+    for (int i = 0; i < kListSize; ++i) {
+        list.push_front(i);
+    }
+}
+
+int main() {
+    measure("куча (::operator new)", [] {
+        FixedBlockMapResource resource(kBufferSize);
+        fill(&resource);
+    });
+
+    measure("внешний буфер на стеке", [] {
+        alignas(std::max_align_t) char buffer[kBufferSize];
+        FixedBlockMapResource resource(buffer, sizeof(buffer));
+        fill(&resource);
+    });
+
+    measure("InlineFixedBlockMapResource", [] {
+        InlineFixedBlockMapResource<kBufferSize> resource;
+        fill(&resource);
+    });
+
+    measure("только ресурс в куче, без списка", [] {
+        FixedBlockMapResource resource(kBufferSize);
+    });
+
+    measure("только внешний буфер, без списка", [] {
+        alignas(std::max_align_t) char buffer[kBufferSize];
+        FixedBlockMapResource resource(buffer, sizeof(buffer));
+    });
+    return 0;
+}
@@ -0,0 +1,159 @@
+#include <chrono>
+#include <cstdint>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <string>
+
+#include "FixedBlockMapResource.h"
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+
+// Резидентная память FixedBlockMapResource после всплеска нагрузки:
+// 256 МиБ выделяются блоками по 64 байта, затем освобождается всё, кроме
+// каждого 4096-го блока (живой блок на каждые 64 страницы). Сравниваются
+// RSS отображения буфера до и после trim() и после повторного заполнения,
+// а также оценка самого ресурса: high_water_mark() - released_bytes().
+// RSS читается из /proc/self/smaps (только Linux).
+
+constexpr size_t kBufferSize = size_t{256} << 20;
+constexpr size_t kBlockSize = 64;
+constexpr size_t kKeepEvery = 4096;
+
+struct MappingUsage {
+    size_t size_kb = 0;
+    size_t rss_kb = 0;
+    size_t lazy_free_kb = 0;
+};
+
+// Найти в smaps отображение, содержащее addr, и прочитать его счётчики
+MappingUsage mapping_usage(const void* addr) {
+    MappingUsage usage;
+    std::ifstream smaps("/proc/self/smaps");
+    uintptr_t target = reinterpret_cast<uintptr_t>(addr);
+    bool inside = false;
+    std::string line;
+    while (std::getline(smaps, line)) {
+        unsigned long long begin = 0;
+        unsigned long long end = 0;
+        // Заголовок отображения: "начало-конец права ..."
+        if (std::sscanf(line.c_str(), "%llx-%llx ", &begin, &end) == 2 &&
+            line.find(':') > line.find(' ')) {
+            if (inside) {
+                break;
+            }
+            inside = target >= begin && target < end;
+            continue;
+        }
+        if (!inside) {
+            continue;
+        }
+        std::istringstream fields(line);
+        std::string key;
+        size_t value = 0;
+        fields >> key >> value;
+        if (key == "Size:") {
+            usage.size_kb = value;
+        } else if (key == "Rss:") {
+            usage.rss_kb = value;
+        } else if (key == "LazyFree:") {
+            usage.lazy_free_kb = value;
+        }
+    }
+    return usage;
+}
+
+void report(const char* stage, const FixedBlockMapResource& resource) {
+    MappingUsage usage = mapping_usage(resource.data());
+    size_t estimate = resource.high_water_mark() - resource.released_bytes();
+    std::cout << stage << ": зарезервировано " << resource.capacity() / 1024
+              << " КиБ, резидентно " << usage.rss_kb << " КиБ (LazyFree "
+              << usage.lazy_free_kb << " КиБ), по оценке ресурса не больше "
+              << estimate / 1024 << " КиБ\n";
+}
+
+#ifdef __linux__
+void run_over(void* buffer, FixedBlockMapResource::TrimMode mode) {
+    FixedBlockMapResource resource(buffer, kBufferSize);
+    report("пустой ресурс", resource);
+
+    // Всплеск: занимаем весь буфер и касаемся каждого блока. Свежий ресурс
+    // выдаёт блоки подряд, поэтому их адреса не нужно хранить.
+    char* base = static_cast<char*>(resource.data());
+    size_t count = 0;
+    while (true) {
+        void* block = nullptr;
+        try {
+            block = resource.allocate(kBlockSize, 8);
+        } catch (const std::bad_alloc&) {
+            break;
+        }
+        if (block != base + count * kBlockSize) {
+            std::cout << "неожиданная раскладка блоков\n";
+            return;
+        }
+        std::memset(block, 1, kBlockSize);
+        ++count;
+    }
+    report("после всплеска", resource);
+
+    for (size_t i = 0; i < count; ++i) {
+        if (i % kKeepEvery != 0) {
+            resource.deallocate(base + i * kBlockSize, kBlockSize, 8);
+        }
+    }
+    report("после освобождения", resource);
+
+    auto start = std::chrono::steady_clock::now();
+    size_t released = resource.trim(mode);
+    auto finish = std::chrono::steady_clock::now();
+    std::cout << "trim: отдано " << released / 1024 << " КиБ за "
+              << std::chrono::duration<double, std::milli>(finish - start)
+                     .count()
+              << " мс\n";
+    report("после trim", resource);
+    std::cout << "повторный trim: отдано " << resource.trim(mode) / 1024
+              << " КиБ\n";
+
+    // Страницы снова используются без каких-либо действий со стороны вызова
+    for (size_t i = 0; i < count / 2; ++i) {
+        std::memset(resource.allocate(kBlockSize, 8), 2, kBlockSize);
+    }
+    report("после повторного заполнения половины", resource);
+}
+
+void run(const char* name, FixedBlockMapResource::TrimMode mode) {
+    std::cout << "== " << name << "\n";
+    // Буфер окружён страницами PROT_NONE, чтобы соседние анонимные
+    // отображения (векторы списков свободных блоков) не слились с ним в
+    // одну запись smaps
+    size_t page = static_cast<size_t>(sysconf(_SC_PAGESIZE));
+    char* region = static_cast<char*>(
+        mmap(nullptr, kBufferSize + 2 * page, PROT_NONE,
+             MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+    if (region == MAP_FAILED) {
+        std::cout << "mmap не удался\n";
+        return;
+    }
+    mprotect(region + page, kBufferSize, PROT_READ | PROT_WRITE);
+    run_over(region + page, mode);
+    munmap(region, kBufferSize + 2 * page);
+}
+
+#endif
+
+int main() {
+#ifdef __linux__
+    run("MADV_DONTNEED", FixedBlockMapResource::TrimMode::DontNeed);
+    run("MADV_FREE", FixedBlockMapResource::TrimMode::LazyFree);
+#else
+    std::cout << "Бенчмарк требует Linux (/proc/self/smaps, madvise)\n";
+#endif
+    return 0;
+}
@@ -0,0 +1,142 @@
+#ifndef ALLOCATION_TRACE_H
+#define ALLOCATION_TRACE_H
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+
+
+// Трассировка горячих путей FixedBlockMapResource.
+//
+// Всё включается только при сборке с LAB05_ENABLE_TRACING (опция CMake
+// LAB05_ENABLE_TRACING). Без неё макросы ниже пустые, а у ресурса нет
+// ни поля tracer_, ни проверок - выключенные хуки ничего не стоят.
+//
+// Статические точки (USDT) доступны, если есть <sys/sdt.h> (systemtap-sdt-dev):
+//   bpftrace -e 'usdt:./lab_05_app:lab05:allocate { @[arg0] = count(); }'
+// Точки: allocate, deallocate, free_list_miss, bump_advance, bad_alloc.
+
+#if defined(LAB05_ENABLE_TRACING) && __has_include(<sys/sdt.h>)
+#include <sys/sdt.h>
+#define LAB05_HAS_USDT 1
+#endif
+
+#ifdef LAB05_HAS_USDT
+#define LAB05_PROBE1(name, a) DTRACE_PROBE1(lab05, name, a)
+#define LAB05_PROBE2(name, a, b) DTRACE_PROBE2(lab05, name, a, b)
+#else
+#define LAB05_PROBE1(name, a) ((void)0)
+#define LAB05_PROBE2(name, a, b) ((void)0)
+#endif
+
+
+// Событие, попавшее в выборку
+enum class AllocationEvent : uint8_t { Allocate, Deallocate };
+
+// Одна измеренная операция ресурса
+struct AllocationSample {
+    uint64_t nanoseconds = 0;
+    size_t bytes = 0;
+    size_t alignment = 0;
+    AllocationEvent event = AllocationEvent::Allocate;
+};
+
+// Кольцевой буфер без блокировок: один писатель (поток, работающий
+// с ресурсом) и один читатель (поток мониторинга). При переполнении
+// новые записи отбрасываются и учитываются в dropped().
+template <size_t Capacity>
+class SampleRing {
+    static_assert((Capacity & (Capacity - 1)) == 0,
+                  "Capacity должна быть степенью двойки");
+
+   private:
+    std::array<AllocationSample, Capacity> samples_;
+    alignas(64) std::atomic<size_t> write_pos_{0};
+    alignas(64) std::atomic<size_t> read_pos_{0};
+    std::atomic<uint64_t> dropped_{0};
+
+   public:
+    // Записать выборку (только поток-писатель)
+    bool push(const AllocationSample& sample) {
+        size_t write = write_pos_.load(std::memory_order_relaxed);
+        size_t read = read_pos_.load(std::memory_order_acquire);
+        if (write - read == Capacity) {
+            dropped_.fetch_add(1, std::memory_order_relaxed);
+            return false;
+        }
+        samples_[write & (Capacity - 1)] = sample;
+        write_pos_.store(write + 1, std::memory_order_release);
+        return true;
+    }
+
+    // Прочитать выборку (только поток-читатель)
+    bool pop(AllocationSample& sample) {
+        size_t read = read_pos_.load(std::memory_order_relaxed);
+        size_t write = write_pos_.load(std::memory_order_acquire);
+        if (read == write) {
+            return false;
+        }
+        sample = samples_[read & (Capacity - 1)];
+        read_pos_.store(read + 1, std::memory_order_release);
+        return true;
+    }
+
+    uint64_t dropped() const {
+        return dropped_.load(std::memory_order_relaxed);
+    }
+};
+
+// Выборочное измерение длительности операций ресурса.
+// Замеряется каждая sample_every-я операция; если задан threshold,
+// в буфер попадают только замеры не короче порога.
+class AllocationTracer {
+   public:
+    using Ring = SampleRing<4096>;
+    using Clock = std::chrono::steady_clock;
+
+   private:
+    uint32_t sample_every_;
+    uint32_t countdown_;
+    std::chrono::nanoseconds threshold_;
+    Ring ring_;
+
+   public:
+    explicit AllocationTracer(
+        uint32_t sample_every = 1024,
+        std::chrono::nanoseconds threshold = std::chrono::nanoseconds(0))
+        : sample_every_(sample_every == 0 ? 1 : sample_every),
+          countdown_(sample_every_),
+          threshold_(threshold) {}
+
+    // Нужно ли замерять текущую операцию
+    bool should_sample() {
+        if (--countdown_ != 0) {
+            return false;
+        }
+        countdown_ = sample_every_;
+        return true;
+    }
+
+    // Сохранить замер, если он не короче порога
+    void record(Clock::time_point start, size_t bytes, size_t alignment,
+                AllocationEvent event) {
+        auto elapsed = Clock::now() - start;
+        if (elapsed < threshold_) {
+            return;
+        }
+        AllocationSample sample;
+        sample.nanoseconds = static_cast<uint64_t>(
+            std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed)
+                .count());
+        sample.bytes = bytes;
+        sample.alignment = alignment;
+        sample.event = event;
+        ring_.push(sample);
+    }
+
+    Ring& samples() { return ring_; }
+};
+
+#endif
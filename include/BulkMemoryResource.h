@@ -0,0 +1,25 @@
+#ifndef BULK_MEMORY_RESOURCE_H
+#define BULK_MEMORY_RESOURCE_H
+
+#include <cstddef>
+#include <memory_resource>
+
+
+// memory_resource, умеющий выделить сразу count блоков одного размера.
+// Каждый блок потом освобождается отдельно обычным deallocate(bytes,
+// alignment), поэтому контейнер может выделять узлы пачкой, а удалять
+// поштучно. Выделение "всё или ничего": при нехватке памяти бросается
+// std::bad_alloc и ни один блок не остаётся занятым.
+class BulkMemoryResource : public std::pmr::memory_resource {
+   public:
+    void allocate_bulk(size_t bytes, size_t alignment, size_t count,
+                       void** out) {
+        do_allocate_bulk(bytes, alignment, count, out);
+    }
+
+   protected:
+    virtual void do_allocate_bulk(size_t bytes, size_t alignment,
+                                  size_t count, void** out) = 0;
+};
+
+#endif
@@ -0,0 +1,306 @@
+#ifndef CHAINED_HASH_MAP_H
+#define CHAINED_HASH_MAP_H
+
+#include <cstddef>
+#include <functional>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <utility>
+
+#include "ForwardList.h"
+
+
+// Хеш-таблица с цепочками. Цепочки собраны из узлов ForwardListNode,
+// массив корзин и все узлы выделяются из одного memory_resource.
+// Рехеширование инкрементальное: при росте создаётся новая таблица,
+// а корзины старой переносятся понемногу при каждой модифицирующей операции.
+template <typename Key, typename Value, typename Hash = std::hash<Key>,
+          typename KeyEqual = std::equal_to<Key>>
+class ChainedHashMap {
+   public:
+    using value_type = std::pair<const Key, Value>;
+
+   private:
+    using Node = ForwardListNode<value_type>;
+    using NodeAllocator = std::pmr::polymorphic_allocator<Node>;
+    using BucketAllocator = std::pmr::polymorphic_allocator<Node*>;
+
+    // Сколько корзин старой таблицы переносится за одну операцию
+    static constexpr size_t kMigrateStep = 4;
+
+    // Таблица корзин: количество корзин всегда степень двойки
+    struct Table {
+        Node** buckets = nullptr;
+        size_t count = 0;
+    };
+
+    Table table_;      // Текущая таблица (в неё идут все вставки)
+    Table old_table_;  // Таблица, из которой идёт перенос (если рехеш идёт)
+    size_t migrate_pos_;  // Первая ещё не перенесённая корзина old_table_
+    size_t size_;
+    float max_load_factor_;
+    NodeAllocator node_allocator_;
+    BucketAllocator bucket_allocator_;
+    Hash hash_;
+    KeyEqual equal_;
+
+    static size_t round_up_pow2(size_t n) {
+        size_t result = 1;
+        while (result < n) {
+            result <<= 1;
+        }
+        return result;
+    }
+
+    Table make_table(size_t count) {
+        Table table;
+        table.buckets = bucket_allocator_.allocate(count);
+        table.count = count;
+        for (size_t i = 0; i < count; ++i) {
+            table.buckets[i] = nullptr;
+        }
+        return table;
+    }
+
+    void free_table(Table& table) {
+        if (table.buckets != nullptr) {
+            bucket_allocator_.deallocate(table.buckets, table.count);
+        }
+        table = Table{};
+    }
+
+    Node*& bucket_for(const Table& table, size_t hash) const {
+        return table.buckets[hash & (table.count - 1)];
+    }
+
+    void destroy_chain(Node* node) {
+        while (node != nullptr) {
+            Node* next = node->next;
+            std::allocator_traits<NodeAllocator>::destroy(node_allocator_,
+                                                          node);
+            node_allocator_.deallocate(node, 1);
+            node = next;
+        }
+    }
+
+    bool rehashing() const { return old_table_.buckets != nullptr; }
+
+    // Перенести до steps корзин из старой таблицы в новую
+    void migrate(size_t steps) {
+        while (rehashing() && steps > 0) {
+            Node* node = old_table_.buckets[migrate_pos_];
+            old_table_.buckets[migrate_pos_] = nullptr;
+            while (node != nullptr) {
+                Node* next = node->next;
+                Node*& bucket = bucket_for(table_, hash_(node->value.first));
+                node->next = bucket;
+                bucket = node;
+                node = next;
+            }
+            ++migrate_pos_;
+            --steps;
+            if (migrate_pos_ == old_table_.count) {
+                free_table(old_table_);
+                migrate_pos_ = 0;
+            }
+        }
+    }
+
+    // Начать рост таблицы, если new_size превысит коэффициент заполнения
+    void grow_if_needed(size_t new_size) {
+        if (static_cast<float>(new_size) <=
+            max_load_factor_ * static_cast<float>(table_.count)) {
+            return;
+        }
+        // Предыдущий перенос ещё не закончен (например, после уменьшения
+        // max_load_factor): ускоряем его, но рост откладываем, чтобы
+        // не переносить всю старую таблицу за одну операцию
+        if (rehashing()) {
+            migrate(kMigrateStep);
+            if (rehashing()) {
+                return;
+            }
+        }
+
+        Table bigger = make_table(table_.count * 2);
+        old_table_ = table_;
+        table_ = bigger;
+        migrate_pos_ = 0;
+    }
+
+    // Найти ссылку на указатель, ведущий к узлу с ключом (или nullptr)
+    Node** find_link(const Key& key, size_t hash) const {
+        Node** link = &bucket_for(table_, hash);
+        while (*link != nullptr) {
+            if (equal_((*link)->value.first, key)) {
+                return link;
+            }
+            link = &(*link)->next;
+        }
+        if (rehashing()) {
+            link = &bucket_for(old_table_, hash);
+            while (*link != nullptr) {
+                if (equal_((*link)->value.first, key)) {
+                    return link;
+                }
+                link = &(*link)->next;
+            }
+        }
+        return nullptr;
+    }
+
+   public:
+    explicit ChainedHashMap(
+        std::pmr::memory_resource* mr = std::pmr::get_default_resource(),
+        size_t bucket_count = 16)
+        : migrate_pos_(0),
+          size_(0),
+          max_load_factor_(1.0f),
+          node_allocator_(mr),
+          bucket_allocator_(mr) {
+        table_ = make_table(round_up_pow2(bucket_count));
+    }
+
+    ~ChainedHashMap() {
+        clear();
+        free_table(table_);
+    }
+
+    // Запрет копирования
+    ChainedHashMap(const ChainedHashMap&) = delete;
+    ChainedHashMap& operator=(const ChainedHashMap&) = delete;
+
+    // Вставить пару, если ключа ещё нет. Возвращает false, если ключ уже есть
+    bool insert(const Key& key, const Value& value) {
+        migrate(kMigrateStep);
+        size_t hash = hash_(key);
+        if (find_link(key, hash) != nullptr) {
+            return false;
+        }
+        grow_if_needed(size_ + 1);
+
+        Node* new_node = node_allocator_.allocate(1);
+        try {
+            node_allocator_.construct(new_node, key, value);
+        } catch (...) {
+            node_allocator_.deallocate(new_node, 1);
+            throw;
+        }
+        Node*& bucket = bucket_for(table_, hash);
+        new_node->next = bucket;
+        bucket = new_node;
+        ++size_;
+        return true;
+    }
+
+    // Доступ по ключу со вставкой значения по умолчанию
+    Value& operator[](const Key& key) {
+        if (Value* found = find(key)) {
+            return *found;
+        }
+        insert(key, Value{});
+        return *find(key);
+    }
+
+    // Найти значение по ключу (nullptr, если ключа нет)
+    Value* find(const Key& key) {
+        Node** link = find_link(key, hash_(key));
+        return link != nullptr ? &(*link)->value.second : nullptr;
+    }
+
+    const Value* find(const Key& key) const {
+        Node** link = find_link(key, hash_(key));
+        return link != nullptr ? &(*link)->value.second : nullptr;
+    }
+
+    bool contains(const Key& key) const { return find(key) != nullptr; }
+
+    // Значение по ключу с проверкой
+    Value& at(const Key& key) {
+        Value* found = find(key);
+        if (found == nullptr) {
+            throw std::out_of_range("Ключ не найден");
+        }
+        return *found;
+    }
+
+    // Удалить ключ. Возвращает false, если ключа не было
+    bool erase(const Key& key) {
+        migrate(kMigrateStep);
+        Node** link = find_link(key, hash_(key));
+        if (link == nullptr) {
+            return false;
+        }
+        Node* victim = *link;
+        *link = victim->next;
+        std::allocator_traits<NodeAllocator>::destroy(node_allocator_, victim);
+        node_allocator_.deallocate(victim, 1);
+        --size_;
+        return true;
+    }
+
+    // Удалить все элементы (массив корзин сохраняется)
+    void clear() {
+        for (size_t i = 0; i < table_.count; ++i) {
+            destroy_chain(table_.buckets[i]);
+            table_.buckets[i] = nullptr;
+        }
+        if (rehashing()) {
+            for (size_t i = migrate_pos_; i < old_table_.count; ++i) {
+                destroy_chain(old_table_.buckets[i]);
+            }
+            free_table(old_table_);
+            migrate_pos_ = 0;
+        }
+        size_ = 0;
+    }
+
+    // Обойти все пары (порядок не определён)
+    template <typename Func>
+    void for_each(Func func) {
+        for (size_t i = 0; i < table_.count; ++i) {
+            for (Node* node = table_.buckets[i]; node != nullptr;
+                 node = node->next) {
+                func(node->value);
+            }
+        }
+        if (rehashing()) {
+            for (size_t i = migrate_pos_; i < old_table_.count; ++i) {
+                for (Node* node = old_table_.buckets[i]; node != nullptr;
+                     node = node->next) {
+                    func(node->value);
+                }
+            }
+        }
+    }
+
+    size_t size() const { return size_; }
+
+    bool empty() const { return size_ == 0; }
+
+    size_t bucket_count() const { return table_.count; }
+
+    float load_factor() const {
+        return static_cast<float>(size_) / static_cast<float>(table_.count);
+    }
+
+    float max_load_factor() const { return max_load_factor_; }
+
+    void max_load_factor(float factor) {
+        if (factor <= 0.0f) {
+            throw std::invalid_argument(
+                "Коэффициент заполнения должен быть > 0");
+        }
+        max_load_factor_ = factor;
+    }
+
+    // Идёт ли сейчас инкрементальный перенос корзин
+    bool is_rehashing() const { return rehashing(); }
+
+    std::pmr::memory_resource* resource() const {
+        return node_allocator_.resource();
+    }
+};
+
+#endif
@@ -0,0 +1,234 @@
+#ifndef COMPACT_FORWARD_LIST_H
+#define COMPACT_FORWARD_LIST_H
+
+#include <cstddef>
+#include <cstdint>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <type_traits>
+#include <utility>
+
+#include "FixedBlockMapResource.h"
+
+
+// Однонаправленный список со сжатыми ссылками. Все узлы живут в буфере
+// одного FixedBlockMapResource, поэтому вместо 8-байтового указателя
+// next хранится 32-битный номер узла: смещение от начала буфера в единицах
+// alignof(Node). Для ForwardList<int> узел занимает 16 байт, здесь - 8.
+//
+// Адресуемый объём буфера - 4 ГиБ * alignof(Node) (16 ГиБ для int,
+// 32 ГиБ для 8-байтовых типов); для большего буфера конструктор бросает
+// std::invalid_argument.
+template <typename T>
+class CompactForwardList {
+   private:
+    static constexpr uint32_t kNull = UINT32_MAX;
+
+    struct Node {
+        using allocator_type = std::pmr::polymorphic_allocator<>;
+
+        T value;
+        uint32_t next;
+
+        template <typename Alloc, typename... Args>
+        Node(std::allocator_arg_t, const Alloc& alloc, Args&&... args)
+            : value(std::make_obj_using_allocator<T>(
+                  alloc, std::forward<Args>(args)...)),
+              next(kNull) {}
+    };
+
+    static constexpr size_t kGranularity = alignof(Node);
+
+    using Allocator = std::pmr::polymorphic_allocator<Node>;
+
+    char* base_;  // Начало буфера ресурса
+    uint32_t head_;
+    uint32_t tail_;
+    Allocator allocator_;
+    size_t size_;
+
+    Node* to_node(uint32_t index) const {
+        return reinterpret_cast<Node*>(base_ + size_t{index} * kGranularity);
+    }
+
+    uint32_t to_index(const Node* node) const {
+        return static_cast<uint32_t>(
+            (reinterpret_cast<const char*>(node) - base_) / kGranularity);
+    }
+
+    template <typename... Args>
+    uint32_t create_node(Args&&... args) {
+        Node* new_node = allocator_.allocate(1);
+        try {
+            allocator_.construct(new_node, std::forward<Args>(args)...);
+        } catch (...) {
+            allocator_.deallocate(new_node, 1);
+            throw;
+        }
+        return to_index(new_node);
+    }
+
+    void destroy_node(uint32_t index) {
+        Node* node = to_node(index);
+        std::allocator_traits<Allocator>::destroy(allocator_, node);
+        allocator_.deallocate(node, 1);
+    }
+
+   public:
+    explicit CompactForwardList(FixedBlockMapResource& resource)
+        : base_(static_cast<char*>(resource.data())),
+          head_(kNull),
+          tail_(kNull),
+          allocator_(&resource),
+          size_(0) {
+        if (resource.capacity() / kGranularity >= kNull) {
+            throw std::invalid_argument(
+                "Буфер слишком велик для 32-битных ссылок");
+        }
+        if (reinterpret_cast<uintptr_t>(base_) % kGranularity != 0) {
+            throw std::invalid_argument("Буфер не выровнен под узлы");
+        }
+    }
+
+    ~CompactForwardList() { clear(); }
+
+    // Запрет копирования
+    CompactForwardList(const CompactForwardList&) = delete;
+    CompactForwardList& operator=(const CompactForwardList&) = delete;
+
+    // Размер узла в байтах (полезная нагрузка + ссылка + выравнивание)
+    static constexpr size_t node_size() { return sizeof(Node); }
+
+    void push_front(const T& value) { emplace_front(value); }
+
+    template <typename... Args>
+    T& emplace_front(Args&&... args) {
+        uint32_t index = create_node(std::forward<Args>(args)...);
+        to_node(index)->next = head_;
+        head_ = index;
+        if (tail_ == kNull) {
+            tail_ = index;
+        }
+        ++size_;
+        return to_node(index)->value;
+    }
+
+    void push_back(const T& value) { emplace_back(value); }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        uint32_t index = create_node(std::forward<Args>(args)...);
+        if (tail_ == kNull) {
+            head_ = index;
+        } else {
+            to_node(tail_)->next = index;
+        }
+        tail_ = index;
+        ++size_;
+        return to_node(index)->value;
+    }
+
+    void pop_front() {
+        if (head_ == kNull) {
+            throw std::runtime_error("Список пуст");
+        }
+        uint32_t old_head = head_;
+        head_ = to_node(head_)->next;
+        if (head_ == kNull) {
+            tail_ = kNull;
+        }
+        destroy_node(old_head);
+        --size_;
+    }
+
+    void clear() {
+        while (head_ != kNull) {
+            uint32_t next = to_node(head_)->next;
+            destroy_node(head_);
+            head_ = next;
+        }
+        tail_ = kNull;
+        size_ = 0;
+    }
+
+    size_t size() const { return size_; }
+
+    bool empty() const { return head_ == kNull; }
+
+    T& front() {
+        if (head_ == kNull) {
+            throw std::runtime_error("Список пуст");
+        }
+        return to_node(head_)->value;
+    }
+
+    const T& front() const {
+        if (head_ == kNull) {
+            throw std::runtime_error("Список пуст");
+        }
+        return to_node(head_)->value;
+    }
+
+    // Итератор хранит начало буфера и 32-битный номер узла
+    template <bool IsConst>
+    class BasicIterator {
+       private:
+        char* base_;
+        uint32_t index_;
+
+        Node* node() const {
+            return reinterpret_cast<Node*>(base_ +
+                                           size_t{index_} * kGranularity);
+        }
+
+       public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = std::conditional_t<IsConst, const T*, T*>;
+        using reference = std::conditional_t<IsConst, const T&, T&>;
+
+        BasicIterator() : base_(nullptr), index_(kNull) {}
+
+        BasicIterator(char* base, uint32_t index)
+            : base_(base), index_(index) {}
+
+        reference operator*() const { return node()->value; }
+
+        pointer operator->() const { return &node()->value; }
+
+        BasicIterator& operator++() {
+            index_ = node()->next;
+            return *this;
+        }
+
+        BasicIterator operator++(int) {
+            BasicIterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const BasicIterator& other) const {
+            return index_ == other.index_;
+        }
+
+        bool operator!=(const BasicIterator& other) const {
+            return !(*this == other);
+        }
+    };
+
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
+    Iterator begin() { return Iterator(base_, head_); }
+
+    Iterator end() { return Iterator(base_, kNull); }
+
+    ConstIterator begin() const { return ConstIterator(base_, head_); }
+
+    ConstIterator end() const { return ConstIterator(base_, kNull); }
+};
+
+#endif
@@ -0,0 +1,261 @@
+#ifndef DEFERRED_FREE_RESOURCE_H
+#define DEFERRED_FREE_RESOURCE_H
+
+#include <algorithm>
+#include <array>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory_resource>
+#include <mutex>
+#include <new>
+#include <thread>
+
+
+// Ресурс-обёртка, откладывающая освобождение памяти. deallocate только
+// дописывает блок в очередь, а реальное освобождение в upstream
+// выполняется порциями не больше kReclaimStep блоков:
+//   OnDemand   - лениво, когда upstream не может выделить память
+//                (bad_alloc): освобождается порция за порцией, пока
+//                выделение не удастся; либо при явном вызове flush();
+//   Background - отдельным потоком, как только накопилось batch_size блоков.
+//
+// Очередь - односвязный список, записи которого (следующий блок, размер,
+// выравнивание - 16 байт) хранятся в самих освобождённых блоках. Поэтому
+// очередь не ограничена, а deallocate не выделяет память и не бросает
+// исключений. Блоки меньше 16 байт (и больше 4 ГиБ) записать некуда -
+// они сразу освобождаются в upstream.
+//
+// Пока блок в очереди, upstream считает его занятым и не выдаёт повторно,
+// поэтому порядок и владение не нарушаются. Все обращения к upstream
+// сериализованы, так что upstream (например, FixedBlockMapResource) может
+// быть непотокобезопасным. upstream должен жить дольше обёртки:
+// деструктор освобождает всё, что осталось в очереди.
+class DeferredFreeResource : public std::pmr::memory_resource {
+   public:
+    enum class Reclaim { OnDemand, Background };
+
+   private:
+    // Сколько блоков освобождается за один захват upstream
+    static constexpr size_t kReclaimStep = 256;
+
+    struct PendingFree {
+        void* ptr;
+        size_t bytes;
+        size_t alignment;
+    };
+
+    // Запись очереди внутри освобождённого блока (копируется memcpy:
+    // выравнивание блока может быть меньше alignof(void*))
+    struct QueuedBlock {
+        void* next;
+        uint32_t bytes;
+        uint32_t alignment;
+    };
+
+    using Step = std::array<PendingFree, kReclaimStep>;
+
+    std::pmr::memory_resource* upstream_;
+    size_t batch_size_;
+
+    // Очередь от старых блоков к новым: count_ блоков
+    void* head_;
+    void* tail_;
+    size_t count_;
+    // Блоки, забранные из очереди, но ещё не возвращённые в upstream
+    size_t in_flight_;
+    // Сколько порций всего вернулось в upstream
+    uint64_t released_steps_;
+    mutable std::mutex pending_mutex_;
+    // Сигнал о том, что порция вернулась в upstream
+    std::condition_variable step_done_;
+
+    std::mutex upstream_mutex_;
+
+    std::thread reclaimer_;
+    std::condition_variable wake_;
+    bool stop_;
+
+    // Забрать из очереди до kReclaimStep самых старых блоков
+    // (вызывается под pending_mutex_)
+    size_t take_step(Step& step) {
+        size_t taken = std::min(count_, kReclaimStep);
+        for (size_t i = 0; i < taken; ++i) {
+            QueuedBlock record;
+            std::memcpy(&record, head_, sizeof(record));
+            step[i] = PendingFree{head_, record.bytes, record.alignment};
+            head_ = record.next;
+        }
+        if (head_ == nullptr) {
+            tail_ = nullptr;
+        }
+        count_ -= taken;
+        in_flight_ += taken;
+        return taken;
+    }
+
+    // Вернуть забранную порцию в upstream (без pending_mutex_)
+    void release_step(const Step& step, size_t taken) {
+        {
+            std::lock_guard<std::mutex> lock(upstream_mutex_);
+            for (size_t i = 0; i < taken; ++i) {
+                upstream_->deallocate(step[i].ptr, step[i].bytes,
+                                      step[i].alignment);
+            }
+        }
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex_);
+            in_flight_ -= taken;
+            ++released_steps_;
+        }
+        step_done_.notify_all();
+    }
+
+    uint64_t released_steps() const {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        return released_steps_;
+    }
+
+    // Освободить одну порцию. Если очередь пуста, а фоновый поток ещё
+    // возвращает свою порцию, дождаться её. Возвращает false, если
+    // возвращать нечего и с момента, когда released_steps() был равен
+    // seen, в upstream не вернулось ни одной порции.
+    bool reclaim_step(uint64_t seen) {
+        Step step;
+        size_t taken = 0;
+        {
+            std::unique_lock<std::mutex> lock(pending_mutex_);
+            step_done_.wait(
+                lock, [this] { return count_ > 0 || in_flight_ == 0; });
+            if (count_ == 0) {
+                return released_steps_ != seen;
+            }
+            taken = take_step(step);
+        }
+        release_step(step, taken);
+        return true;
+    }
+
+    void reclaim_loop() {
+        Step step;
+        std::unique_lock<std::mutex> lock(pending_mutex_);
+        while (!stop_) {
+            // Таймаут подбирает хвост, не набравший целую пачку
+            wake_.wait_for(lock, std::chrono::milliseconds(10), [this] {
+                return stop_ || count_ >= batch_size_;
+            });
+            while (count_ > 0 && !stop_) {
+                size_t taken = take_step(step);
+                lock.unlock();
+                release_step(step, taken);
+                lock.lock();
+            }
+        }
+    }
+
+   protected:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+        while (true) {
+            // Порция, вернувшаяся после этой точки, даёт повод повторить
+            uint64_t seen = released_steps();
+            {
+                std::lock_guard<std::mutex> lock(upstream_mutex_);
+                try {
+                    return upstream_->allocate(bytes, alignment);
+                } catch (const std::bad_alloc&) {
+                    // Промах: освобождаем порцию отложенных блоков и
+                    // пробуем снова
+                }
+            }
+            if (!reclaim_step(seen)) {
+                throw std::bad_alloc();
+            }
+        }
+    }
+
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+        if (bytes < sizeof(QueuedBlock) || bytes > UINT32_MAX ||
+            alignment > UINT32_MAX) {
+            // Запись в блок не помещается - освобождаем сразу
+            std::lock_guard<std::mutex> lock(upstream_mutex_);
+            upstream_->deallocate(ptr, bytes, alignment);
+            return;
+        }
+
+        QueuedBlock record{nullptr, static_cast<uint32_t>(bytes),
+                           static_cast<uint32_t>(alignment)};
+        std::memcpy(ptr, &record, sizeof(record));
+        bool wake = false;
+        {
+            std::lock_guard<std::mutex> lock(pending_mutex_);
+            if (tail_ == nullptr) {
+                head_ = ptr;
+            } else {
+                // next - первое поле записи
+                std::memcpy(tail_, &ptr, sizeof(ptr));
+            }
+            tail_ = ptr;
+            ++count_;
+            wake = reclaimer_.joinable() && count_ == batch_size_;
+        }
+        if (wake) {
+            wake_.notify_one();
+        }
+    }
+
+    bool do_is_equal(
+        const std::pmr::memory_resource& other) const noexcept override {
+        return this == &other;
+    }
+
+   public:
+    explicit DeferredFreeResource(std::pmr::memory_resource* upstream,
+                                  Reclaim mode = Reclaim::OnDemand,
+                                  size_t batch_size = 4096)
+        : upstream_(upstream),
+          batch_size_(batch_size == 0 ? 1 : batch_size),
+          head_(nullptr),
+          tail_(nullptr),
+          count_(0),
+          in_flight_(0),
+          released_steps_(0),
+          stop_(false) {
+        if (mode == Reclaim::Background) {
+            reclaimer_ = std::thread([this] { reclaim_loop(); });
+        }
+    }
+
+    ~DeferredFreeResource() {
+        if (reclaimer_.joinable()) {
+            {
+                std::lock_guard<std::mutex> lock(pending_mutex_);
+                stop_ = true;
+            }
+            wake_.notify_one();
+            reclaimer_.join();
+        }
+        flush();
+    }
+
+    // Запрет копирования
+    DeferredFreeResource(const DeferredFreeResource&) = delete;
+    DeferredFreeResource& operator=(const DeferredFreeResource&) = delete;
+
+    // Освободить все отложенные блоки прямо сейчас
+    void flush() {
+        while (reclaim_step(released_steps())) {
+        }
+    }
+
+    // Сколько блоков ждёт освобождения (в очереди и в работе)
+    size_t pending() const {
+        std::lock_guard<std::mutex> lock(pending_mutex_);
+        return count_ + in_flight_;
+    }
+
+    std::pmr::memory_resource* upstream_resource() const { return upstream_; }
+};
+
+#endif
@@ -1,17 +1,35 @@
 #ifndef FIXED_BLOCK_MAP_RESOURCE_H
 #define FIXED_BLOCK_MAP_RESOURCE_H
 
+#include <algorithm>
 #include <cstddef>
+#include <cstdint>
+#include <iterator>
 #include <map>
 #include <memory_resource>
 #include <vector>
 
+#include "AllocationTrace.h"
+#include "BulkMemoryResource.h"
+
+#ifdef __linux__
+#include <sys/mman.h>
+#include <unistd.h>
+#endif
+
+class FixedBlockMapResource : public BulkMemoryResource {
+   public:
+    // Как отдавать неиспользуемые страницы системе
+    enum class TrimMode {
+        DontNeed,  // MADV_DONTNEED: RSS уменьшается сразу
+        LazyFree   // MADV_FREE: ядро забирает страницы при нехватке памяти
+    };
 
-class FixedBlockMapResource : public std::pmr::memory_resource {
    private:
     void* buffer_;        // Фиксированный блок памяти
     size_t buffer_size_;  // Размер буфера
     size_t offset_;  // Текущая позиция для выделения
+    bool owns_buffer_;  // Буфер выделен ресурсом (иначе предоставлен извне)
 
     // Карта занятых блоков: адрес -> размер
     std::map<void*, size_t> allocated_blocks_;
@@ -19,14 +37,185 @@ class FixedBlockMapResource : public std::pmr::memory_resource {
     // Карта свободных блоков: размер -> список адресов
     std::map<size_t, std::vector<void*>> free_blocks_;
 
-   protected:
+    size_t free_bytes_ = 0;      // Байт в списке свободных блоков
+    size_t released_bytes_ = 0;  // Байт сейчас передано системе
+
+    // Страницы, переданные системе: начало -> конец. Участки не
+    // пересекаются с занятыми блоками и лежат ниже offset_.
+    std::map<char*, char*> released_runs_;
+
+    size_t trim_watermark_ = 0;  // Порог автоматической обрезки (0 - нет)
+    // free_bytes_ после последней обрезки или меньший с тех пор
+    size_t free_at_trim_ = 0;
+    // Диапазон адресов блоков, освобождённых с последней обрезки
+    // (ведётся, только если включена автоматическая обрезка)
+    char* dirty_first_ = nullptr;
+    char* dirty_last_ = nullptr;
+
+#ifdef LAB05_ENABLE_TRACING
+    AllocationTracer* tracer_ = nullptr;  // Выборочные замеры (если заданы)
+#endif
+
+#ifdef __linux__
+    static uintptr_t page_size() {
+        static const uintptr_t page =
+            static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+        return page;
+    }
+
+    // Отдать системе страницы [first, last) (границы выровнены по странице)
+    static size_t release_pages(char* first, char* last, TrimMode mode) {
+        void* addr = first;
+        size_t length = static_cast<size_t>(last - first);
+#ifdef MADV_FREE
+        // Ядра старше 4.5 не знают MADV_FREE - тогда падаем на DONTNEED
+        if (mode == TrimMode::LazyFree &&
+            madvise(addr, length, MADV_FREE) == 0) {
+            return length;
+        }
+#else
+        (void)mode;
+#endif
+        return madvise(addr, length, MADV_DONTNEED) == 0 ? length : 0;
+    }
+
+    // Запомнить отданный участок, склеив его с соседними
+    void add_released_run(char* first, char* last) {
+        auto next = released_runs_.lower_bound(first);
+        if (next != released_runs_.end() && next->first == last) {
+            last = next->second;
+            next = released_runs_.erase(next);
+        }
+        if (next != released_runs_.begin()) {
+            auto prev = std::prev(next);
+            if (prev->second == first) {
+                prev->second = last;
+                return;
+            }
+        }
+        released_runs_.emplace_hint(next, first, last);
+    }
+
+    // Отдать системе целые страницы свободного промежутка [first, last)
+    // между занятыми блоками, кроме уже отданных. Возвращает число байт,
+    // отданных этим вызовом.
+    size_t release_gap(char* first, char* last, TrimMode mode) {
+        uintptr_t page = page_size();
+        char* start = reinterpret_cast<char*>(
+            (reinterpret_cast<uintptr_t>(first) + page - 1) & ~(page - 1));
+        char* end = reinterpret_cast<char*>(
+            reinterpret_cast<uintptr_t>(last) & ~(page - 1));
+        if (start >= end) {
+            return 0;
+        }
+
+        // Отданные участки внутри промежутка целиком лежат в [start, end)
+        size_t released = 0;
+        char* cursor = start;
+        while (cursor < end) {
+            // Дыра до следующего отданного участка (или до конца)
+            char* hole_end = end;
+            char* next_cursor = end;
+            auto run = released_runs_.lower_bound(cursor);
+            if (run != released_runs_.end() && run->first < end) {
+                hole_end = run->first;
+                next_cursor = run->second;
+            }
+            if (cursor < hole_end) {
+                size_t length = release_pages(cursor, hole_end, mode);
+                if (length != 0) {
+                    add_released_run(cursor, hole_end);
+                    released_bytes_ += length;
+                    released += length;
+                }
+            }
+            cursor = next_cursor;
+        }
+        return released;
+    }
+#endif
+
+    // Блок [first, last) снова используется: его страницы больше не
+    // считаются отданными (при записи ядро вернёт их в RSS)
+    void reuse_released(char* first, char* last) {
+#ifdef __linux__
+        uintptr_t page = page_size();
+        first = reinterpret_cast<char*>(
+            reinterpret_cast<uintptr_t>(first) & ~(page - 1));
+        last = reinterpret_cast<char*>(
+            (reinterpret_cast<uintptr_t>(last) + page - 1) & ~(page - 1));
+
+        auto run = released_runs_.upper_bound(first);
+        if (run != released_runs_.begin() &&
+            std::prev(run)->second > first) {
+            --run;
+        }
+        while (run != released_runs_.end() && run->first < last) {
+            char* run_first = run->first;
+            char* run_last = run->second;
+            run = released_runs_.erase(run);
+            char* cut_first = std::max(run_first, first);
+            char* cut_last = std::min(run_last, last);
+            released_bytes_ -= static_cast<size_t>(cut_last - cut_first);
+            if (run_first < cut_first) {
+                released_runs_.emplace_hint(run, run_first, cut_first);
+            }
+            if (cut_last < run_last) {
+                released_runs_.emplace_hint(run, cut_last, run_last);
+            }
+        }
+#else
+        (void)first;
+        (void)last;
+#endif
+    }
+
+    // Автоматическая обрезка: обходит только промежутки внутри диапазона
+    // адресов, освобождённых с прошлой обрезки, а не все занятые блоки
+    void trim_dirty() {
+#ifdef __linux__
+        char* base = static_cast<char*>(buffer_);
+        // Промежуток, в котором лежит начало диапазона
+        auto next = allocated_blocks_.lower_bound(dirty_first_);
+        char* gap_first = base;
+        if (next != allocated_blocks_.begin()) {
+            auto prev = std::prev(next);
+            gap_first = static_cast<char*>(prev->first) + prev->second;
+        }
+        while (true) {
+            char* gap_last = next == allocated_blocks_.end()
+                                 ? base + offset_
+                                 : static_cast<char*>(next->first);
+            release_gap(gap_first, gap_last, TrimMode::DontNeed);
+            if (gap_last >= dirty_last_ || next == allocated_blocks_.end()) {
+                break;
+            }
+            gap_first = gap_last + next->second;
+            ++next;
+        }
+#endif
+        reset_dirty();
+    }
+
+    void reset_dirty() {
+        dirty_first_ = nullptr;
+        dirty_last_ = nullptr;
+        free_at_trim_ = free_bytes_;
+    }
+
     // Выделить память из буфера
-    void* do_allocate(size_t bytes, size_t alignment) override {
+    void* allocate_block(size_t bytes, size_t alignment) {
+        LAB05_PROBE2(allocate, bytes, alignment);
+
         // Сначала ищем в свободных блоках
         for (auto it = free_blocks_.begin(); it != free_blocks_.end(); ++it) {
-            if (it->first >= bytes && !it->second.empty()) {
+            if (it->first >= bytes && !it->second.empty() &&
+                reinterpret_cast<uintptr_t>(it->second.back()) % alignment ==
+                    0) {
                 void* ptr = it->second.back();
                 it->second.pop_back();
+                free_bytes_ -= it->first;
+                free_at_trim_ = std::min(free_at_trim_, free_bytes_);
 
                 // Если вектор пустой, удаляем запись
                 if (it->second.empty()) {
@@ -34,27 +223,39 @@ class FixedBlockMapResource : public std::pmr::memory_resource {
                 }
 
                 allocated_blocks_[ptr] = bytes;
+                if (!released_runs_.empty()) {
+                    reuse_released(static_cast<char*>(ptr),
+                                   static_cast<char*>(ptr) + bytes);
+                }
                 return ptr;
             }
         }
 
-        // Выравниваем offset по alignment
-        size_t padding = (alignment - (offset_ % alignment)) % alignment;
+        LAB05_PROBE1(free_list_miss, bytes);
+
+        // Выравниваем offset по alignment (по абсолютному адресу, т.к.
+        // внешний буфер может быть выровнен хуже, чем запрошено)
+        uintptr_t address = reinterpret_cast<uintptr_t>(buffer_) + offset_;
+        size_t padding = (alignment - (address % alignment)) % alignment;
         size_t aligned_offset = offset_ + padding;
 
         // Проверяем, хватает ли места в буфере
         if (aligned_offset + bytes > buffer_size_) {
+            LAB05_PROBE2(bad_alloc, bytes, buffer_size_ - offset_);
             throw std::bad_alloc();
         }
 
         void* ptr = static_cast<char*>(buffer_) + aligned_offset;
         allocated_blocks_[ptr] = bytes;
         offset_ = aligned_offset + bytes;
+        LAB05_PROBE2(bump_advance, aligned_offset, offset_);
         return ptr;
     }
 
     // Освободить блок (добавить в список свободных)
-    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+    void deallocate_block(void* ptr) {
+        LAB05_PROBE1(deallocate, ptr);
+
         auto it = allocated_blocks_.find(ptr);
         if (it == allocated_blocks_.end()) {
             return;
@@ -65,6 +266,101 @@ class FixedBlockMapResource : public std::pmr::memory_resource {
 
         // Добавляем в список свободных блоков
         free_blocks_[block_size].push_back(ptr);
+
+        free_bytes_ += block_size;
+        if (trim_watermark_ != 0) {
+            char* first = static_cast<char*>(ptr);
+            if (dirty_first_ == nullptr || first < dirty_first_) {
+                dirty_first_ = first;
+            }
+            dirty_last_ = std::max(dirty_last_, first + block_size);
+            // Порог считается от свободной сейчас памяти: блоки, снова
+            // выданные из списка свободных, его не приближают
+            if (free_bytes_ >= free_at_trim_ + trim_watermark_) {
+                try {
+                    trim_dirty();
+                } catch (const std::bad_alloc&) {
+                    // Не хватило памяти под учёт отданных страниц:
+                    // обрезка необязательна, блок уже освобождён
+                    reset_dirty();
+                }
+            }
+        }
+    }
+
+   protected:
+    void* do_allocate(size_t bytes, size_t alignment) override {
+#ifdef LAB05_ENABLE_TRACING
+        if (tracer_ != nullptr && tracer_->should_sample()) {
+            auto start = AllocationTracer::Clock::now();
+            void* ptr = allocate_block(bytes, alignment);
+            tracer_->record(start, bytes, alignment,
+                            AllocationEvent::Allocate);
+            return ptr;
+        }
+#endif
+        return allocate_block(bytes, alignment);
+    }
+
+    void do_deallocate(void* ptr, size_t bytes, size_t alignment) override {
+#ifdef LAB05_ENABLE_TRACING
+        if (tracer_ != nullptr && tracer_->should_sample()) {
+            auto start = AllocationTracer::Clock::now();
+            deallocate_block(ptr);
+            tracer_->record(start, bytes, alignment,
+                            AllocationEvent::Deallocate);
+            return;
+        }
+#endif
+        deallocate_block(ptr);
+    }
+
+    // Выделить count блоков подряд из хвоста буфера: одна проверка места,
+    // а записи в карту добавляются в её конец (адреса растут). Если хвоста
+    // не хватает, блоки выделяются поштучно, в том числе из свободных.
+    void do_allocate_bulk(size_t bytes, size_t alignment, size_t count,
+                          void** out) override {
+        if (count == 0) {
+            return;
+        }
+        LAB05_PROBE2(allocate_bulk, bytes, count);
+
+        size_t stride = (bytes + alignment - 1) / alignment * alignment;
+        uintptr_t address = reinterpret_cast<uintptr_t>(buffer_) + offset_;
+        size_t padding = (alignment - (address % alignment)) % alignment;
+        size_t aligned_offset = offset_ + padding;
+        if (aligned_offset + bytes <= buffer_size_ &&
+            (buffer_size_ - aligned_offset - bytes) / stride >= count - 1) {
+            char* first = static_cast<char*>(buffer_) + aligned_offset;
+            size_t done = 0;
+            try {
+                for (; done < count; ++done) {
+                    out[done] = first + done * stride;
+                    allocated_blocks_.emplace_hint(allocated_blocks_.end(),
+                                                   out[done], bytes);
+                }
+            } catch (...) {
+                for (size_t i = 0; i < done; ++i) {
+                    allocated_blocks_.erase(out[i]);
+                }
+                throw;
+            }
+            offset_ = aligned_offset + (count - 1) * stride + bytes;
+            LAB05_PROBE2(bump_advance, aligned_offset, offset_);
+            return;
+        }
+
+        size_t done = 0;
+        try {
+            for (; done < count; ++done) {
+                out[done] = allocate_block(bytes, alignment);
+            }
+        } catch (...) {
+            for (size_t i = 0; i < done; ++i) {
+                deallocate_block(out[i]);
+            }
+            throw;
+        }
     }
 
     // Сравнение с другим resource
@@ -76,16 +372,109 @@ class FixedBlockMapResource : public std::pmr::memory_resource {
    public:
     // Конструктор: выделяем один большой блок памяти
     explicit FixedBlockMapResource(size_t size)
-        : buffer_size_(size), offset_(0) {
+        : buffer_size_(size), offset_(0), owns_buffer_(true) {
         buffer_ = ::operator new(buffer_size_);
     }
 
-    // Деструктор: освобождаем весь буфер
-    ~FixedBlockMapResource() { ::operator delete(buffer_); }
+    // Конструктор над внешним буфером (массив на стеке, статическая память,
+    // участок другого ресурса). Буфер не освобождается ресурсом и должен
+    // жить дольше него.
+    FixedBlockMapResource(void* buffer, size_t size)
+        : buffer_(buffer),
+          buffer_size_(size),
+          offset_(0),
+          owns_buffer_(false) {}
+
+    // Деструктор: освобождаем весь буфер, если он наш
+    ~FixedBlockMapResource() {
+        if (owns_buffer_) {
+            ::operator delete(buffer_);
+        }
+    }
 
     // Запрет копирования
     FixedBlockMapResource(const FixedBlockMapResource&) = delete;
     FixedBlockMapResource& operator=(const FixedBlockMapResource&) = delete;
+
+    // Начало буфера и его размер
+    void* data() const { return buffer_; }
+
+    size_t capacity() const { return buffer_size_; }
+
+    // Сколько байт буфера уже задействовано (позиция указателя выделения).
+    // Учёт блоков (std::map) хранится вне буфера, в глобальной куче.
+    size_t high_water_mark() const { return offset_; }
+
+    // Принадлежит ли адрес буферу ресурса
+    bool owns(const void* ptr) const {
+        const char* begin = static_cast<const char*>(buffer_);
+        const char* p = static_cast<const char*>(ptr);
+        return p >= begin && p < begin + buffer_size_;
+    }
+
+    // Вернуть системе страницы, целиком лежащие вне занятых блоков
+    // (свободные блоки, промежутки выравнивания) ниже позиции выделения.
+    // Уже отданные страницы не затрагиваются, хвост буфера, к которому
+    // ещё не обращались, тоже. Страницы остаются в адресном пространстве
+    // и снова используются при следующих выделениях; после DontNeed они
+    // читаются как нули. Обходит все занятые блоки.
+    // Буфер должен быть частной анонимной памятью (куча, стек, mmap).
+    // Возвращает число байт, отданных этим вызовом; вне Linux ничего не
+    // делает.
+    size_t trim(TrimMode mode = TrimMode::DontNeed) {
+        reset_dirty();
+#ifdef __linux__
+        // allocated_blocks_ упорядочена по адресу: свободны промежутки
+        char* run_begin = static_cast<char*>(buffer_);
+        size_t released = 0;
+        for (const auto& [ptr, size] : allocated_blocks_) {
+            released += release_gap(run_begin, static_cast<char*>(ptr), mode);
+            run_begin = static_cast<char*>(ptr) + size;
+        }
+        released += release_gap(
+            run_begin, static_cast<char*>(buffer_) + offset_, mode);
+        return released;
+#else
+        (void)mode;
+        return 0;
+#endif
+    }
+
+    // Обрезать (DontNeed) автоматически, когда байт в списке свободных
+    // стало на watermark больше, чем в самой низкой точке с последней
+    // обрезки (0 - отключить). Обрезка затрагивает только промежутки в
+    // диапазоне адресов блоков, освобождённых с тех пор, и не выделяет
+    // память под этот учёт.
+    void set_trim_watermark(size_t watermark) {
+        trim_watermark_ = watermark;
+        reset_dirty();
+    }
+
+    // Сколько байт сейчас передано системе. Резидентно не больше, чем
+    // high_water_mark() - released_bytes().
+    size_t released_bytes() const { return released_bytes_; }
+
+#ifdef LAB05_ENABLE_TRACING
+    // Подключить выборочные замеры (nullptr - отключить)
+    void set_tracer(AllocationTracer* tracer) { tracer_ = tracer; }
+#endif
+};
+
+// Хранилище для InlineFixedBlockMapResource: отдельная база, чтобы массив
+// был создан раньше ресурса
+template <size_t Size>
+struct FixedBlockMapStorage {
+    alignas(std::max_align_t) std::byte storage_[Size];
+};
+
+// Ресурс с буфером внутри самого объекта: без обращения к куче за буфером,
+// можно разместить на стеке или в статической памяти
+template <size_t Size>
+class InlineFixedBlockMapResource : private FixedBlockMapStorage<Size>,
+                                    public FixedBlockMapResource {
+   public:
+    InlineFixedBlockMapResource()
+        : FixedBlockMapResource(this->storage_, Size) {}
 };
 
 #endif
@@ -1,34 +1,139 @@
 #ifndef FORWARD_LIST_H
 #define FORWARD_LIST_H
 
+#include <algorithm>
+#include <cstddef>
 #include <iterator>
+#include <memory>
 #include <memory_resource>
 #include <stdexcept>
+#include <type_traits>
+#include <utility>
 
+#include "BulkMemoryResource.h"
+
+
+template <typename... Args>
+constexpr bool kStartsWithAllocatorArg = false;
+
+template <typename First, typename... Rest>
+constexpr bool kStartsWithAllocatorArg<First, Rest...> =
+    std::is_same_v<std::remove_cvref_t<First>, std::allocator_arg_t>;
+
+// Узел однонаправленного списка (используется также цепочками ChainedHashMap).
+// Узел поддерживает uses-allocator протокол: polymorphic_allocator::construct
+// передаёт ему свой ресурс, а узел - значению (например, std::pmr::string),
+// так что вложенные pmr-данные попадают в тот же memory_resource.
+template <typename T>
+struct ForwardListNode {
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
+    T value;
+    ForwardListNode* next;
+
+    template <typename... Args>
+        requires(!kStartsWithAllocatorArg<Args...>)
+    explicit ForwardListNode(Args&&... args)
+        : value(std::forward<Args>(args)...), next(nullptr) {}
+
+    template <typename Alloc, typename... Args>
+    ForwardListNode(std::allocator_arg_t, const Alloc& alloc, Args&&... args)
+        : value(std::make_obj_using_allocator<T>(
+              alloc, std::forward<Args>(args)...)),
+          next(nullptr) {}
+};
 
 // Шаблонный однонаправленный
 template <typename T>
 class ForwardList {
    private:
     // Узел списка
-    struct Node {
-        T value;
-        Node* next;
-
-        Node(const T& val) : value(val), next(nullptr) {}
-    };
+    using Node = ForwardListNode<T>;
 
     using Allocator = std::pmr::polymorphic_allocator<Node>;
 
+    // Сколько узлов append_range запрашивает за один allocate_bulk
+    static constexpr size_t kBulkNodes = 256;
+
     Node* head_;
+    Node* tail_;  // Последний узел (для O(1) добавления в конец)
     Allocator allocator_;
     size_t size_;
 
+    // Выделить и сконструировать узел; при исключении память возвращается
+    template <typename... Args>
+    Node* create_node(Args&&... args) {
+        Node* new_node = allocator_.allocate(1);
+        try {
+            allocator_.construct(new_node, std::forward<Args>(args)...);
+        } catch (...) {
+            allocator_.deallocate(new_node, 1);
+            throw;
+        }
+        return new_node;
+    }
+
+    void destroy_node(Node* node) {
+        std::allocator_traits<Allocator>::destroy(allocator_, node);
+        allocator_.deallocate(node, 1);
+    }
+
+    void link_back(Node* new_node) {
+        if (tail_ == nullptr) {
+            head_ = new_node;
+        } else {
+            tail_->next = new_node;
+        }
+        tail_ = new_node;
+        ++size_;
+    }
+
+    // Сконструировать n узлов из элементов, начиная с first, в памяти
+    // одного allocate_bulk и передать их в link. Возвращает итератор за
+    // последним использованным элементом.
+    template <typename It, typename Link>
+    It construct_bulk(BulkMemoryResource& bulk, It first, size_t n,
+                      Link& link) {
+        void* blocks[kBulkNodes];
+        bulk.allocate_bulk(sizeof(Node), alignof(Node), n, blocks);
+        size_t built = 0;
+        try {
+            for (; built < n; ++built, ++first) {
+                Node* new_node = static_cast<Node*>(blocks[built]);
+                allocator_.construct(new_node, *first);
+                link(new_node);
+            }
+        } catch (...) {
+            for (size_t i = built; i < n; ++i) {
+                allocator_.deallocate(static_cast<Node*>(blocks[i]), 1);
+            }
+            throw;
+        }
+        return first;
+    }
+
+    // Забрать узлы другого списка (ресурсы должны совпадать)
+    void steal(ForwardList& other) noexcept {
+        head_ = other.head_;
+        tail_ = other.tail_;
+        size_ = other.size_;
+        other.head_ = nullptr;
+        other.tail_ = nullptr;
+        other.size_ = 0;
+    }
+
    public:
+    // Список - allocator-aware контейнер: при вложении в другие pmr-контейнеры
+    // (и в сам ForwardList) он получает их memory_resource
+    using allocator_type = std::pmr::polymorphic_allocator<T>;
+
     // Конструктор с memory_resource
     explicit ForwardList(
         std::pmr::memory_resource* mr = std::pmr::get_default_resource())
-        : head_(nullptr), allocator_(mr), size_(0) {}
+        : head_(nullptr), tail_(nullptr), allocator_(mr), size_(0) {}
+
+    explicit ForwardList(const allocator_type& alloc)
+        : ForwardList(alloc.resource()) {}
 
     ~ForwardList() { clear(); }
 
@@ -36,13 +141,145 @@ class ForwardList {
     ForwardList(const ForwardList&) = delete;
     ForwardList& operator=(const ForwardList&) = delete;
 
+    // Перемещение: узлы переходят вместе с memory_resource
+    ForwardList(ForwardList&& other) noexcept
+        : head_(nullptr), tail_(nullptr), allocator_(other.allocator_),
+          size_(0) {
+        steal(other);
+    }
+
+    // Перемещение в список с заданным ресурсом: при другом ресурсе
+    // элементы перемещаются поштучно в новые узлы
+    ForwardList(ForwardList&& other, const allocator_type& alloc)
+        : ForwardList(alloc.resource()) {
+        append(other);
+    }
+
+    // Ресурс списка не меняется (polymorphic_allocator не распространяется
+    // при присваивании), поэтому при разных ресурсах элементы перемещаются
+    ForwardList& operator=(ForwardList&& other) {
+        if (this == &other) {
+            return *this;
+        }
+        clear();
+        append(other);
+        return *this;
+    }
+
+    allocator_type get_allocator() const { return allocator_type(resource()); }
+
     // Добавить элемент в начало
-    void push_front(const T& value) {
-        Node* new_node = allocator_.allocate(1);
-        allocator_.construct(new_node, value);
+    void push_front(const T& value) { emplace_front(value); }
+
+    void push_front(T&& value) { emplace_front(std::move(value)); }
+
+    template <typename... Args>
+    T& emplace_front(Args&&... args) {
+        Node* new_node = create_node(std::forward<Args>(args)...);
         new_node->next = head_;
         head_ = new_node;
+        if (tail_ == nullptr) {
+            tail_ = new_node;
+        }
         ++size_;
+        return new_node->value;
+    }
+
+    // Добавить элемент в конец за O(1)
+    void push_back(const T& value) { emplace_back(value); }
+
+    void push_back(T&& value) { emplace_back(std::move(value)); }
+
+    template <typename... Args>
+    T& emplace_back(Args&&... args) {
+        Node* new_node = create_node(std::forward<Args>(args)...);
+        link_back(new_node);
+        return new_node->value;
+    }
+
+    // Перенести все элементы other в конец списка (other становится пустым).
+    // При общем memory_resource узлы перецепляются за O(1),
+    // иначе элементы перемещаются поштучно в узлы этого списка.
+    void append(ForwardList& other) {
+        if (this == &other || other.head_ == nullptr) {
+            return;
+        }
+        if (allocator_ == other.allocator_) {
+            if (tail_ == nullptr) {
+                steal(other);
+                return;
+            }
+            tail_->next = other.head_;
+            tail_ = other.tail_;
+            size_ += other.size_;
+            other.head_ = nullptr;
+            other.tail_ = nullptr;
+            other.size_ = 0;
+            return;
+        }
+        for (Node* node = other.head_; node != nullptr; node = node->next) {
+            emplace_back(std::move(node->value));
+        }
+        other.clear();
+    }
+
+    // Добавить диапазон в конец. Узлы собираются в отдельную цепочку
+    // и пристыковываются одной операцией: при исключении список не меняется.
+    // Если длина диапазона известна заранее (forward-итераторы), а ресурс -
+    // BulkMemoryResource, память под узлы берётся пачками по kBulkNodes.
+    template <typename InputIt>
+    void append_range(InputIt first, InputIt last) {
+        Node* chain_head = nullptr;
+        Node* chain_tail = nullptr;
+        size_t count = 0;
+        auto link = [&](Node* new_node) {
+            if (chain_tail == nullptr) {
+                chain_head = new_node;
+            } else {
+                chain_tail->next = new_node;
+            }
+            chain_tail = new_node;
+            ++count;
+        };
+        try {
+            // move_iterator в C++20 моделирует только input_iterator,
+            // поэтому смотрим на категорию исходного итератора
+            if constexpr (std::is_base_of_v<
+                              std::forward_iterator_tag,
+                              typename std::iterator_traits<
+                                  InputIt>::iterator_category>) {
+                auto* bulk = dynamic_cast<BulkMemoryResource*>(resource());
+                if (bulk != nullptr) {
+                    size_t remaining =
+                        static_cast<size_t>(std::distance(first, last));
+                    while (remaining > 0) {
+                        size_t n = std::min(remaining, kBulkNodes);
+                        first = construct_bulk(*bulk, first, n, link);
+                        remaining -= n;
+                    }
+                }
+            }
+            for (; first != last; ++first) {
+                link(create_node(*first));
+            }
+        } catch (...) {
+            while (chain_head != nullptr) {
+                Node* next = chain_head->next;
+                destroy_node(chain_head);
+                chain_head = next;
+            }
+            throw;
+        }
+        if (chain_head == nullptr) {
+            return;
+        }
+        if (tail_ == nullptr) {
+            head_ = chain_head;
+        } else {
+            tail_->next = chain_head;
+        }
+        tail_ = chain_tail;
+        size_ += count;
     }
 
     // Удалить первый элемент
@@ -52,8 +289,10 @@ class ForwardList {
         }
         Node* old_head = head_;
         head_ = head_->next;
-        std::allocator_traits<Allocator>::destroy(allocator_, old_head);
-        allocator_.deallocate(old_head, 1);
+        if (head_ == nullptr) {
+            tail_ = nullptr;
+        }
+        destroy_node(old_head);
         --size_;
     }
 
@@ -61,10 +300,10 @@ class ForwardList {
     void clear() {
         while (head_ != nullptr) {
             Node* next = head_->next;
-            std::allocator_traits<Allocator>::destroy(allocator_, head_);
-            allocator_.deallocate(head_, 1);
+            destroy_node(head_);
             head_ = next;
         }
+        tail_ = nullptr;
         size_ = 0;
     }
 
@@ -87,47 +326,90 @@ class ForwardList {
         return head_->value;
     }
 
-    // Итератор
-    class Iterator {
+    // Получить последний элемент
+    T& back() {
+        if (tail_ == nullptr) {
+            throw std::runtime_error("Список пуст");
+        }
+        return tail_->value;
+    }
+
+    const T& back() const {
+        if (tail_ == nullptr) {
+            throw std::runtime_error("Список пуст");
+        }
+        return tail_->value;
+    }
+
+    std::pmr::memory_resource* resource() const {
+        return allocator_.resource();
+    }
+
+    // Итератор (IsConst = true - только для чтения)
+    template <bool IsConst>
+    class BasicIterator {
        private:
-        Node* current_;
+        using NodePtr = std::conditional_t<IsConst, const Node*, Node*>;
+
+        NodePtr current_;
 
        public:
         using iterator_category = std::forward_iterator_tag;
         using value_type = T;
         using difference_type = std::ptrdiff_t;
-        using pointer = T*;
-        using reference = T&;
+        using pointer = std::conditional_t<IsConst, const T*, T*>;
+        using reference = std::conditional_t<IsConst, const T&, T&>;
+
+        BasicIterator() : current_(nullptr) {}
+
+        explicit BasicIterator(NodePtr node) : current_(node) {}
 
-        explicit Iterator(Node* node) : current_(node) {}
+        // Неконстантный итератор приводится к константному
+        template <bool OtherConst,
+                  typename = std::enable_if_t<IsConst && !OtherConst>>
+        BasicIterator(const BasicIterator<OtherConst>& other)
+            : current_(other.node()) {}
 
         reference operator*() const { return current_->value; }
 
         pointer operator->() const { return &current_->value; }
 
-        Iterator& operator++() {
+        BasicIterator& operator++() {
             current_ = current_->next;
             return *this;
         }
 
-        Iterator operator++(int) {
-            Iterator tmp = *this;
+        BasicIterator operator++(int) {
+            BasicIterator tmp = *this;
             ++(*this);
             return tmp;
         }
 
-        bool operator==(const Iterator& other) const {
+        bool operator==(const BasicIterator& other) const {
             return current_ == other.current_;
         }
 
-        bool operator!=(const Iterator& other) const {
+        bool operator!=(const BasicIterator& other) const {
             return !(*this == other);
         }
+
+        NodePtr node() const { return current_; }
     };
 
+    using Iterator = BasicIterator<false>;
+    using ConstIterator = BasicIterator<true>;
+
     Iterator begin() { return Iterator(head_); }
 
     Iterator end() { return Iterator(nullptr); }
+
+    ConstIterator begin() const { return ConstIterator(head_); }
+
+    ConstIterator end() const { return ConstIterator(nullptr); }
+
+    ConstIterator cbegin() const { return ConstIterator(head_); }
+
+    ConstIterator cend() const { return ConstIterator(nullptr); }
 };
 
 #endif
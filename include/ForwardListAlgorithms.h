@@ -0,0 +1,509 @@
+#ifndef FORWARD_LIST_ALGORITHMS_H
+#define FORWARD_LIST_ALGORITHMS_H
+
+#include <algorithm>
+#include <cstddef>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <type_traits>
+
+#include "ForwardList.h"
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+#include <immintrin.h>
+#define LAB05_SIMD_X86 1
+#endif
+
+
+// Редукции для ForwardList<int> и ForwardList<double>: сумма, минимум,
+// максимум, count_if и скалярное произведение двух списков.
+//
+// Узлы списка лежат в памяти не подряд, поэтому значения сначала собираются
+// пачками по kReduceBatch в выровненный буфер на стеке, а к буферу
+// применяется векторное ядро. Ядро выбирается во время выполнения:
+// AVX2, SSE4.1 или скалярное (на других платформах - только скалярное).
+//
+// list_min/list_max для double одинаковы на всех уровнях: если в списке
+// есть NaN, результат - NaN (minpd/maxpd и std::min/std::max сами по себе
+// обрабатывают NaN по-разному, поэтому NaN проверяется отдельно). Знак
+// нуля при равных -0.0 и +0.0 от уровня может зависеть.
+//
+// list_flatten копирует элементы списка в непрерывный массив (для любых
+// копируемых T) - для передачи в код, работающий с массивами.
+
+enum class SimdLevel { Scalar, Sse41, Avx2 };
+
+// Лучший уровень, который поддерживает процессор
+inline SimdLevel detected_simd_level() {
+#ifdef LAB05_SIMD_X86
+    static const SimdLevel level = [] {
+        __builtin_cpu_init();
+        if (__builtin_cpu_supports("avx2")) {
+            return SimdLevel::Avx2;
+        }
+        if (__builtin_cpu_supports("sse4.1")) {
+            return SimdLevel::Sse41;
+        }
+        return SimdLevel::Scalar;
+    }();
+    return level;
+#else
+    return SimdLevel::Scalar;
+#endif
+}
+
+// Сумма целых считается в long long, чтобы не переполняться
+template <typename T>
+using ReduceSum = std::conditional_t<std::is_integral_v<T>, long long, T>;
+
+constexpr size_t kReduceBatch = 1024;
+
+namespace simd_detail {
+
+// ---------------------------- Скалярные ядра ----------------------------
+
+template <typename T>
+ReduceSum<T> sum_scalar(const T* data, size_t n) {
+    ReduceSum<T> sum = 0;
+    for (size_t i = 0; i < n; ++i) {
+        sum += data[i];
+    }
+    return sum;
+}
+
+template <typename T>
+ReduceSum<T> dot_scalar(const T* a, const T* b, size_t n) {
+    ReduceSum<T> sum = 0;
+    for (size_t i = 0; i < n; ++i) {
+        sum += static_cast<ReduceSum<T>>(a[i]) * b[i];
+    }
+    return sum;
+}
+
+// Минимум или максимум двух значений; NaN в любом аргументе даёт NaN
+template <bool IsMax, typename T>
+T pick(T a, T b) {
+    if constexpr (std::is_floating_point_v<T>) {
+        if (a != a) {
+            return a;
+        }
+        if (b != b) {
+            return b;
+        }
+    }
+    return IsMax ? std::max(a, b) : std::min(a, b);
+}
+
+template <typename T>
+T min_scalar(const T* data, size_t n) {
+    T result = data[0];
+    for (size_t i = 1; i < n; ++i) {
+        result = pick<false>(result, data[i]);
+    }
+    return result;
+}
+
+template <typename T>
+T max_scalar(const T* data, size_t n) {
+    T result = data[0];
+    for (size_t i = 1; i < n; ++i) {
+        result = pick<true>(result, data[i]);
+    }
+    return result;
+}
+
+#ifdef LAB05_SIMD_X86
+
+// ------------------------------ Ядра AVX2 -------------------------------
+
+__attribute__((target("avx2"))) inline long long sum_avx2(const int* data,
+                                                          size_t n) {
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(data + i));
+        acc = _mm256_add_epi64(acc, _mm256_cvtepi32_epi64(v));
+    }
+    alignas(32) long long lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+           sum_scalar(data + i, n - i);
+}
+
+__attribute__((target("avx2"))) inline double sum_avx2(const double* data,
+                                                       size_t n) {
+    __m256d acc0 = _mm256_setzero_pd();
+    __m256d acc1 = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 8 <= n; i += 8) {
+        acc0 = _mm256_add_pd(acc0, _mm256_load_pd(data + i));
+        acc1 = _mm256_add_pd(acc1, _mm256_load_pd(data + i + 4));
+    }
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, _mm256_add_pd(acc0, acc1));
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+           sum_scalar(data + i, n - i);
+}
+
+__attribute__((target("avx2"))) inline long long dot_avx2(const int* a,
+                                                          const int* b,
+                                                          size_t n) {
+    __m256i acc = _mm256_setzero_si256();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256i va = _mm256_cvtepi32_epi64(
+            _mm_load_si128(reinterpret_cast<const __m128i*>(a + i)));
+        __m256i vb = _mm256_cvtepi32_epi64(
+            _mm_load_si128(reinterpret_cast<const __m128i*>(b + i)));
+        acc = _mm256_add_epi64(acc, _mm256_mul_epi32(va, vb));
+    }
+    alignas(32) long long lanes[4];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+           dot_scalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("avx2"))) inline double dot_avx2(const double* a,
+                                                       const double* b,
+                                                       size_t n) {
+    __m256d acc = _mm256_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        acc = _mm256_add_pd(
+            acc, _mm256_mul_pd(_mm256_load_pd(a + i), _mm256_load_pd(b + i)));
+    }
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, acc);
+    return lanes[0] + lanes[1] + lanes[2] + lanes[3] +
+           dot_scalar(a + i, b + i, n - i);
+}
+
+template <bool IsMax>
+__attribute__((target("avx2"))) int extreme_avx2(const int* data, size_t n) {
+    if (n < 8) {
+        return IsMax ? max_scalar(data, n) : min_scalar(data, n);
+    }
+    __m256i acc = _mm256_load_si256(reinterpret_cast<const __m256i*>(data));
+    size_t i = 8;
+    for (; i + 8 <= n; i += 8) {
+        __m256i v =
+            _mm256_load_si256(reinterpret_cast<const __m256i*>(data + i));
+        acc = IsMax ? _mm256_max_epi32(acc, v) : _mm256_min_epi32(acc, v);
+    }
+    alignas(32) int lanes[8];
+    _mm256_store_si256(reinterpret_cast<__m256i*>(lanes), acc);
+    int result = IsMax ? max_scalar(lanes, 8) : min_scalar(lanes, 8);
+    for (; i < n; ++i) {
+        result = pick<IsMax>(result, data[i]);
+    }
+    return result;
+}
+
+template <bool IsMax>
+__attribute__((target("avx2"))) double extreme_avx2(const double* data,
+                                                    size_t n) {
+    if (n < 4) {
+        return IsMax ? max_scalar(data, n) : min_scalar(data, n);
+    }
+    __m256d acc = _mm256_load_pd(data);
+    __m256d nan = _mm256_cmp_pd(acc, acc, _CMP_UNORD_Q);
+    size_t i = 4;
+    for (; i + 4 <= n; i += 4) {
+        __m256d v = _mm256_load_pd(data + i);
+        nan = _mm256_or_pd(nan, _mm256_cmp_pd(v, v, _CMP_UNORD_Q));
+        acc = IsMax ? _mm256_max_pd(acc, v) : _mm256_min_pd(acc, v);
+    }
+    if (_mm256_movemask_pd(nan) != 0) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    alignas(32) double lanes[4];
+    _mm256_store_pd(lanes, acc);
+    double result = IsMax ? max_scalar(lanes, 4) : min_scalar(lanes, 4);
+    for (; i < n; ++i) {
+        result = pick<IsMax>(result, data[i]);
+    }
+    return result;
+}
+
+// ----------------------------- Ядра SSE4.1 ------------------------------
+
+__attribute__((target("sse4.1"))) inline long long sum_sse41(const int* data,
+                                                             size_t n) {
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(data + i));
+        acc = _mm_add_epi64(acc, _mm_cvtepi32_epi64(v));
+        acc = _mm_add_epi64(acc, _mm_cvtepi32_epi64(_mm_srli_si128(v, 8)));
+    }
+    alignas(16) long long lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    return lanes[0] + lanes[1] + sum_scalar(data + i, n - i);
+}
+
+__attribute__((target("sse4.1"))) inline double sum_sse41(const double* data,
+                                                          size_t n) {
+    __m128d acc0 = _mm_setzero_pd();
+    __m128d acc1 = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        acc0 = _mm_add_pd(acc0, _mm_load_pd(data + i));
+        acc1 = _mm_add_pd(acc1, _mm_load_pd(data + i + 2));
+    }
+    alignas(16) double lanes[2];
+    _mm_store_pd(lanes, _mm_add_pd(acc0, acc1));
+    return lanes[0] + lanes[1] + sum_scalar(data + i, n - i);
+}
+
+__attribute__((target("sse4.1"))) inline long long dot_sse41(const int* a,
+                                                             const int* b,
+                                                             size_t n) {
+    __m128i acc = _mm_setzero_si128();
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128i va = _mm_cvtepi32_epi64(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(a + i)));
+        __m128i vb = _mm_cvtepi32_epi64(
+            _mm_loadl_epi64(reinterpret_cast<const __m128i*>(b + i)));
+        acc = _mm_add_epi64(acc, _mm_mul_epi32(va, vb));
+    }
+    alignas(16) long long lanes[2];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    return lanes[0] + lanes[1] + dot_scalar(a + i, b + i, n - i);
+}
+
+__attribute__((target("sse4.1"))) inline double dot_sse41(const double* a,
+                                                          const double* b,
+                                                          size_t n) {
+    __m128d acc = _mm_setzero_pd();
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        acc = _mm_add_pd(acc,
+                         _mm_mul_pd(_mm_load_pd(a + i), _mm_load_pd(b + i)));
+    }
+    alignas(16) double lanes[2];
+    _mm_store_pd(lanes, acc);
+    return lanes[0] + lanes[1] + dot_scalar(a + i, b + i, n - i);
+}
+
+template <bool IsMax>
+__attribute__((target("sse4.1"))) int extreme_sse41(const int* data,
+                                                    size_t n) {
+    if (n < 4) {
+        return IsMax ? max_scalar(data, n) : min_scalar(data, n);
+    }
+    __m128i acc = _mm_load_si128(reinterpret_cast<const __m128i*>(data));
+    size_t i = 4;
+    for (; i + 4 <= n; i += 4) {
+        __m128i v = _mm_load_si128(reinterpret_cast<const __m128i*>(data + i));
+        acc = IsMax ? _mm_max_epi32(acc, v) : _mm_min_epi32(acc, v);
+    }
+    alignas(16) int lanes[4];
+    _mm_store_si128(reinterpret_cast<__m128i*>(lanes), acc);
+    int result = IsMax ? max_scalar(lanes, 4) : min_scalar(lanes, 4);
+    for (; i < n; ++i) {
+        result = pick<IsMax>(result, data[i]);
+    }
+    return result;
+}
+
+template <bool IsMax>
+__attribute__((target("sse4.1"))) double extreme_sse41(const double* data,
+                                                       size_t n) {
+    if (n < 2) {
+        return data[0];
+    }
+    __m128d acc = _mm_load_pd(data);
+    __m128d nan = _mm_cmpunord_pd(acc, acc);
+    size_t i = 2;
+    for (; i + 2 <= n; i += 2) {
+        __m128d v = _mm_load_pd(data + i);
+        nan = _mm_or_pd(nan, _mm_cmpunord_pd(v, v));
+        acc = IsMax ? _mm_max_pd(acc, v) : _mm_min_pd(acc, v);
+    }
+    if (_mm_movemask_pd(nan) != 0) {
+        return std::numeric_limits<double>::quiet_NaN();
+    }
+    alignas(16) double lanes[2];
+    _mm_store_pd(lanes, acc);
+    double result = pick<IsMax>(lanes[0], lanes[1]);
+    for (; i < n; ++i) {
+        result = pick<IsMax>(result, data[i]);
+    }
+    return result;
+}
+
+#endif  // LAB05_SIMD_X86
+
+// ------------------------------ Диспетчер -------------------------------
+
+template <typename T>
+ReduceSum<T> sum(const T* data, size_t n, SimdLevel level) {
+#ifdef LAB05_SIMD_X86
+    if (level == SimdLevel::Avx2) {
+        return sum_avx2(data, n);
+    }
+    if (level == SimdLevel::Sse41) {
+        return sum_sse41(data, n);
+    }
+#endif
+    (void)level;
+    return sum_scalar(data, n);
+}
+
+template <typename T>
+ReduceSum<T> dot(const T* a, const T* b, size_t n, SimdLevel level) {
+#ifdef LAB05_SIMD_X86
+    if (level == SimdLevel::Avx2) {
+        return dot_avx2(a, b, n);
+    }
+    if (level == SimdLevel::Sse41) {
+        return dot_sse41(a, b, n);
+    }
+#endif
+    (void)level;
+    return dot_scalar(a, b, n);
+}
+
+template <bool IsMax, typename T>
+T extreme(const T* data, size_t n, SimdLevel level) {
+#ifdef LAB05_SIMD_X86
+    if (level == SimdLevel::Avx2) {
+        return extreme_avx2<IsMax>(data, n);
+    }
+    if (level == SimdLevel::Sse41) {
+        return extreme_sse41<IsMax>(data, n);
+    }
+#endif
+    (void)level;
+    return IsMax ? max_scalar(data, n) : min_scalar(data, n);
+}
+
+// Запрошенный уровень, но не выше поддерживаемого процессором
+inline SimdLevel clamp_level(SimdLevel level) {
+    return std::min(level, detected_simd_level());
+}
+
+// Собрать следующие элементы списка в буфер; возвращает их число
+template <typename It>
+size_t gather(It& it, It end, typename It::value_type* buffer) {
+    size_t count = 0;
+    while (count < kReduceBatch && it != end) {
+        buffer[count++] = *it;
+        ++it;
+    }
+    return count;
+}
+
+template <typename T>
+void check_reducible() {
+    static_assert(std::is_same_v<T, int> || std::is_same_v<T, double>,
+                  "Редукции реализованы для int и double");
+}
+
+}  // namespace simd_detail
+
+// Сумма элементов
+template <typename T>
+ReduceSum<T> list_sum(const ForwardList<T>& list,
+                      SimdLevel level = detected_simd_level()) {
+    simd_detail::check_reducible<T>();
+    level = simd_detail::clamp_level(level);
+    alignas(32) T buffer[kReduceBatch];
+    ReduceSum<T> total = 0;
+    auto it = list.begin();
+    while (size_t n = simd_detail::gather(it, list.end(), buffer)) {
+        total += simd_detail::sum(buffer, n, level);
+    }
+    return total;
+}
+
+// Минимальный элемент (исключение для пустого списка)
+template <typename T>
+T list_min(const ForwardList<T>& list,
+           SimdLevel level = detected_simd_level()) {
+    simd_detail::check_reducible<T>();
+    if (list.empty()) {
+        throw std::runtime_error("Список пуст");
+    }
+    level = simd_detail::clamp_level(level);
+    alignas(32) T buffer[kReduceBatch];
+    T result = list.front();
+    auto it = list.begin();
+    while (size_t n = simd_detail::gather(it, list.end(), buffer)) {
+        result = simd_detail::pick<false>(
+            result, simd_detail::extreme<false>(buffer, n, level));
+    }
+    return result;
+}
+
+// Максимальный элемент (исключение для пустого списка)
+template <typename T>
+T list_max(const ForwardList<T>& list,
+           SimdLevel level = detected_simd_level()) {
+    simd_detail::check_reducible<T>();
+    if (list.empty()) {
+        throw std::runtime_error("Список пуст");
+    }
+    level = simd_detail::clamp_level(level);
+    alignas(32) T buffer[kReduceBatch];
+    T result = list.front();
+    auto it = list.begin();
+    while (size_t n = simd_detail::gather(it, list.end(), buffer)) {
+        result = simd_detail::pick<true>(
+            result, simd_detail::extreme<true>(buffer, n, level));
+    }
+    return result;
+}
+
+// Скопировать элементы списка подряд в out (не больше out.size()).
+// Возвращает число скопированных элементов.
+template <typename T>
+size_t list_flatten(const ForwardList<T>& list, std::span<T> out) {
+    size_t copied = 0;
+    for (auto it = list.begin(); it != list.end() && copied < out.size();
+         ++it) {
+        out[copied++] = *it;
+    }
+    return copied;
+}
+
+// Количество элементов, удовлетворяющих предикату. Предикат произвольный,
+// поэтому векторизуется только сбор значений в буфер.
+template <typename T, typename Pred>
+size_t list_count_if(const ForwardList<T>& list, Pred pred) {
+    simd_detail::check_reducible<T>();
+    alignas(32) T buffer[kReduceBatch];
+    size_t count = 0;
+    auto it = list.begin();
+    while (size_t n = simd_detail::gather(it, list.end(), buffer)) {
+        for (size_t i = 0; i < n; ++i) {
+            count += pred(buffer[i]) ? 1 : 0;
+        }
+    }
+    return count;
+}
+
+// Скалярное произведение двух списков одинаковой длины
+template <typename T>
+ReduceSum<T> list_dot(const ForwardList<T>& a, const ForwardList<T>& b,
+                      SimdLevel level = detected_simd_level()) {
+    simd_detail::check_reducible<T>();
+    if (a.size() != b.size()) {
+        throw std::invalid_argument("Списки разной длины");
+    }
+    level = simd_detail::clamp_level(level);
+    alignas(32) T buffer_a[kReduceBatch];
+    alignas(32) T buffer_b[kReduceBatch];
+    ReduceSum<T> total = 0;
+    auto it_a = a.begin();
+    auto it_b = b.begin();
+    while (size_t n = simd_detail::gather(it_a, a.end(), buffer_a)) {
+        simd_detail::gather(it_b, b.end(), buffer_b);
+        total += simd_detail::dot(buffer_a, buffer_b, n, level);
+    }
+    return total;
+}
+
+#endif
@@ -0,0 +1,231 @@
+#ifndef FORWARD_LIST_IO_H
+#define FORWARD_LIST_IO_H
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <istream>
+#include <iterator>
+#include <ostream>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <vector>
+
+#include "ForwardList.h"
+
+
+// Потоковая двоичная сериализация ForwardList.
+//
+// Формат: заголовок "FLST" + версия, затем кадры
+//   [uint32 число элементов][uint32 число байт][байты элементов],
+// последний кадр - с нулём элементов. Числа пишутся в порядке байт
+// текущей платформы. Элементы копятся в буфере и пишутся одним write
+// на кадр; чтение идёт кадрами, поэтому память ограничена размером кадра.
+//
+// Элемент кодируется через ListCodec<T>. Для тривиально копируемых типов
+// кодек есть по умолчанию; для остальных нужна специализация с функциями
+//   static void encode(const T& value, std::vector<char>& out);
+//   static T decode(const char*& cursor, const char* end);
+// и, по желанию, константой kMaxEncodedSize - наибольшим размером одного
+// закодированного элемента (без неё считается kListIOChunkBytes). Кадр
+// длиннее kListIOChunkBytes + kMaxEncodedSize при чтении отвергается.
+
+
+// Примерный размер кадра
+constexpr size_t kListIOChunkBytes = 1 << 20;
+
+// Запись и чтение простых значений - для реализации кодеков
+template <typename T>
+void write_pod(std::vector<char>& out, const T& value) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    size_t old_size = out.size();
+    out.resize(old_size + sizeof(T));
+    std::memcpy(out.data() + old_size, &value, sizeof(T));
+}
+
+template <typename T>
+T read_pod(const char*& cursor, const char* end) {
+    static_assert(std::is_trivially_copyable_v<T>);
+    if (static_cast<size_t>(end - cursor) < sizeof(T)) {
+        throw std::runtime_error("Повреждённые данные списка");
+    }
+    T value;
+    std::memcpy(&value, cursor, sizeof(T));
+    cursor += sizeof(T);
+    return value;
+}
+
+// Кодек по умолчанию: побайтовая копия
+template <typename T>
+struct ListCodec {
+    static_assert(std::is_trivially_copyable_v<T>,
+                  "Для нетривиального типа нужна специализация ListCodec");
+
+    static constexpr size_t kMaxEncodedSize = sizeof(T);
+
+    static void encode(const T& value, std::vector<char>& out) {
+        write_pod(out, value);
+    }
+
+    static T decode(const char*& cursor, const char* end) {
+        return read_pod<T>(cursor, end);
+    }
+};
+
+// Кодек для строк: длина + символы (строки не длиннее kMaxLength)
+template <>
+struct ListCodec<std::string> {
+    static constexpr size_t kMaxLength = size_t{16} << 20;
+    static constexpr size_t kMaxEncodedSize = sizeof(uint32_t) + kMaxLength;
+
+    static void encode(const std::string& value, std::vector<char>& out) {
+        if (value.size() > kMaxLength) {
+            throw std::length_error("Строка слишком длинна для сериализации");
+        }
+        write_pod(out, static_cast<uint32_t>(value.size()));
+        out.insert(out.end(), value.begin(), value.end());
+    }
+
+    static std::string decode(const char*& cursor, const char* end) {
+        uint32_t length = read_pod<uint32_t>(cursor, end);
+        if (static_cast<size_t>(end - cursor) < length) {
+            throw std::runtime_error("Повреждённые данные списка");
+        }
+        std::string value(cursor, length);
+        cursor += length;
+        return value;
+    }
+};
+
+namespace list_io_detail {
+
+// Кодек по умолчанию позволяет копировать кадр целиком одним memcpy
+template <typename T, typename Codec>
+constexpr bool kRawCopy =
+    std::is_same_v<Codec, ListCodec<T>> && std::is_trivially_copyable_v<T>;
+
+// Наибольший допустимый размер данных кадра для кодека
+template <typename Codec>
+constexpr size_t max_frame_bytes() {
+    if constexpr (requires { Codec::kMaxEncodedSize; }) {
+        return kListIOChunkBytes + Codec::kMaxEncodedSize;
+    } else {
+        return 2 * kListIOChunkBytes;
+    }
+}
+
+constexpr char kMagic[4] = {'F', 'L', 'S', 'T'};
+constexpr uint32_t kVersion = 1;
+
+inline void write_frame(std::ostream& out, std::vector<char>& frame,
+                        uint32_t count) {
+    uint32_t header[2] = {count, 0};
+    header[1] = static_cast<uint32_t>(frame.size() - sizeof(header));
+    std::memcpy(frame.data(), header, sizeof(header));
+    out.write(frame.data(), static_cast<std::streamsize>(frame.size()));
+    if (!out) {
+        throw std::runtime_error("Ошибка записи списка");
+    }
+    frame.resize(sizeof(header));
+}
+
+inline void read_exact(std::istream& in, char* data, size_t size) {
+    in.read(data, static_cast<std::streamsize>(size));
+    if (static_cast<size_t>(in.gcount()) != size) {
+        throw std::runtime_error("Неожиданный конец данных списка");
+    }
+}
+
+}  // namespace list_io_detail
+
+// Записать список в поток
+template <typename T, typename Codec = ListCodec<T>>
+void serialize(const ForwardList<T>& list, std::ostream& out) {
+    using namespace list_io_detail;
+
+    out.write(kMagic, sizeof(kMagic));
+    out.write(reinterpret_cast<const char*>(&kVersion), sizeof(kVersion));
+
+    // Первые 8 байт кадра - место под заголовок
+    std::vector<char> frame(2 * sizeof(uint32_t));
+    frame.reserve(kListIOChunkBytes + 2 * sizeof(uint32_t));
+    uint32_t count = 0;
+    for (const T& value : list) {
+        Codec::encode(value, frame);
+        ++count;
+        if (frame.size() >= kListIOChunkBytes) {
+            write_frame(out, frame, count);
+            count = 0;
+        }
+    }
+    if (count > 0) {
+        write_frame(out, frame, count);
+    }
+    write_frame(out, frame, 0);
+}
+
+// Прочитать поток пачками: func вызывается с std::span<T> на каждый кадр.
+// В памяти одновременно находится только один кадр.
+template <typename T, typename Codec = ListCodec<T>, typename Func>
+void deserialize_batches(std::istream& in, Func func) {
+    using namespace list_io_detail;
+
+    char magic[sizeof(kMagic)];
+    uint32_t version = 0;
+    read_exact(in, magic, sizeof(magic));
+    read_exact(in, reinterpret_cast<char*>(&version), sizeof(version));
+    if (std::memcmp(magic, kMagic, sizeof(kMagic)) != 0 ||
+        version != kVersion) {
+        throw std::runtime_error("Неизвестный формат списка");
+    }
+
+    std::vector<char> bytes;
+    std::vector<T> batch;
+    while (true) {
+        uint32_t header[2];
+        read_exact(in, reinterpret_cast<char*>(header), sizeof(header));
+        if (header[0] == 0) {
+            return;
+        }
+        // Каждый элемент занимает хотя бы один байт, а кадр не может быть
+        // больше, чем пишет serialize: иначе память не была бы ограничена
+        if (header[0] > header[1] || header[1] > max_frame_bytes<Codec>()) {
+            throw std::runtime_error("Повреждённые данные списка");
+        }
+
+        bytes.resize(header[1]);
+        read_exact(in, bytes.data(), bytes.size());
+
+        batch.clear();
+        if constexpr (kRawCopy<T, Codec>) {
+            if (bytes.size() != size_t{header[0]} * sizeof(T)) {
+                throw std::runtime_error("Повреждённые данные списка");
+            }
+            batch.resize(header[0]);
+            std::memcpy(batch.data(), bytes.data(), bytes.size());
+        } else {
+            // Число элементов из заголовка ещё не проверено декодированием
+            batch.reserve(std::min<size_t>(header[0],
+                                           kListIOChunkBytes / sizeof(T)));
+            const char* cursor = bytes.data();
+            const char* end = cursor + bytes.size();
+            for (uint32_t i = 0; i < header[0]; ++i) {
+                batch.push_back(Codec::decode(cursor, end));
+            }
+        }
+        func(std::span<T>(batch));
+    }
+}
+
+// Прочитать поток и добавить элементы в конец списка
+template <typename T, typename Codec = ListCodec<T>>
+void deserialize(std::istream& in, ForwardList<T>& list) {
+    deserialize_batches<T, Codec>(in, [&list](std::span<T> batch) {
+        list.append_range(std::make_move_iterator(batch.begin()),
+                          std::make_move_iterator(batch.end()));
+    });
+}
+
+#endif
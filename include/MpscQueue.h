@@ -0,0 +1,117 @@
+#ifndef MPSC_QUEUE_H
+#define MPSC_QUEUE_H
+
+#include <atomic>
+#include <memory>
+#include <memory_resource>
+#include <new>
+#include <optional>
+#include <utility>
+
+
+// Очередь "много производителей - один потребитель" по схеме Вьюкова
+// (с узлом-заглушкой). push не ждёт других потоков: один atomic exchange
+// и одна запись. pop вызывается только одним потоком-потребителем.
+//
+// Очередь не интрузивная и не строится на ForwardListNode: она сама владеет
+// узлами, связь next атомарная, а у заглушки нет значения, поэтому значение
+// хранится в сыром буфере узла.
+//
+// Узлы выделяются из memory_resource из разных потоков, поэтому ресурс
+// должен быть потокобезопасным (например, synchronized_pool_resource).
+// FixedBlockMapResource для этого не подходит.
+template <typename T>
+class MpscQueue {
+   private:
+    // Узел очереди: значение хранится в сыром буфере, т.к. у заглушки его нет
+    struct Node {
+        std::atomic<Node*> next;
+        alignas(T) unsigned char storage[sizeof(T)];
+
+        Node() : next(nullptr) {}
+
+        T* value() { return std::launder(reinterpret_cast<T*>(storage)); }
+    };
+
+    using Allocator = std::pmr::polymorphic_allocator<Node>;
+
+    // Производители пишут в head_, потребитель читает tail_ - разносим
+    // их по разным кэш-линиям
+    alignas(64) std::atomic<Node*> head_;
+    alignas(64) Node* tail_;
+    Allocator allocator_;
+
+    Node* create_stub() {
+        Node* stub = allocator_.allocate(1);
+        allocator_.construct(stub);
+        return stub;
+    }
+
+    void destroy_node(Node* node) {
+        std::allocator_traits<Allocator>::destroy(allocator_, node);
+        allocator_.deallocate(node, 1);
+    }
+
+   public:
+    explicit MpscQueue(
+        std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+        : allocator_(mr) {
+        Node* stub = create_stub();
+        head_.store(stub, std::memory_order_relaxed);
+        tail_ = stub;
+    }
+
+    // Деструктор: вызывать, когда производители уже остановлены
+    ~MpscQueue() {
+        while (pop()) {
+        }
+        destroy_node(tail_);
+    }
+
+    // Запрет копирования
+    MpscQueue(const MpscQueue&) = delete;
+    MpscQueue& operator=(const MpscQueue&) = delete;
+
+    // Добавить элемент (можно вызывать из любого числа потоков)
+    void push(const T& value) { emplace(value); }
+
+    void push(T&& value) { emplace(std::move(value)); }
+
+    template <typename... Args>
+    void emplace(Args&&... args) {
+        Node* node = allocator_.allocate(1);
+        try {
+            allocator_.construct(node);
+            ::new (static_cast<void*>(node->storage))
+                T(std::forward<Args>(args)...);
+        } catch (...) {
+            allocator_.deallocate(node, 1);
+            throw;
+        }
+        Node* prev = head_.exchange(node, std::memory_order_acq_rel);
+        prev->next.store(node, std::memory_order_release);
+    }
+
+    // Извлечь элемент (только поток-потребитель). Пустой optional, если
+    // очередь пуста или производитель ещё не успел связать свой узел.
+    std::optional<T> pop() {
+        Node* tail = tail_;
+        Node* next = tail->next.load(std::memory_order_acquire);
+        if (next == nullptr) {
+            return std::nullopt;
+        }
+        // Узел next становится новой заглушкой: забираем из него значение
+        std::optional<T> result(std::move(*next->value()));
+        std::destroy_at(next->value());
+        tail_ = next;
+        destroy_node(tail);
+        return result;
+    }
+
+    // Пуста ли очередь с точки зрения потребителя
+    bool empty() const {
+        return tail_->next.load(std::memory_order_acquire) == nullptr;
+    }
+};
+
+#endif
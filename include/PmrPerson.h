@@ -0,0 +1,31 @@
+#ifndef PMR_PERSON_H
+#define PMR_PERSON_H
+
+#include <memory_resource>
+#include <string>
+#include <string_view>
+#include <utility>
+
+
+// Person с pmr-строкой, поддерживающий uses-allocator протокол: в
+// ForwardList имя хранится в том же memory_resource, что и узел.
+// Используется демонстрационной программой и тестами.
+struct PmrPerson {
+    using allocator_type = std::pmr::polymorphic_allocator<>;
+
+    int id;
+    std::pmr::string name;
+
+    PmrPerson(int i, std::string_view n, const allocator_type& alloc = {})
+        : id(i), name(n, alloc) {}
+
+    PmrPerson(const PmrPerson& other, const allocator_type& alloc = {})
+        : id(other.id), name(other.name, alloc) {}
+
+    PmrPerson(PmrPerson&& other, const allocator_type& alloc)
+        : id(other.id), name(std::move(other.name), alloc) {}
+
+    PmrPerson(PmrPerson&& other) = default;
+};
+
+#endif
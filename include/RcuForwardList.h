@@ -0,0 +1,318 @@
+#ifndef RCU_FORWARD_LIST_H
+#define RCU_FORWARD_LIST_H
+
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <deque>
+#include <iterator>
+#include <memory>
+#include <memory_resource>
+#include <stdexcept>
+#include <utility>
+
+
+// Однонаправленный список для сценария "много читателей, один писатель"
+// (в духе RCU). Читатели обходят список без блокировок и без атомарных
+// read-modify-write операций: вход в чтение - запись номера эпохи в свой
+// слот и барьер памяти. Писатель публикует изменения release-записями,
+// а удалённые узлы откладывает и возвращает в memory_resource только
+// после того, как все читатели, которые могли их видеть, вышли из чтения
+// (эпохальная схема освобождения).
+//
+// Изменять список (push_front, pop_front, erase_after, try_reclaim)
+// может только один поток. memory_resource используется только им.
+template <typename T>
+class RcuForwardList {
+   private:
+    struct Node {
+        using allocator_type = std::pmr::polymorphic_allocator<>;
+
+        T value;
+        std::atomic<Node*> next;
+
+        template <typename Alloc, typename... Args>
+        Node(std::allocator_arg_t, const Alloc& alloc, Args&&... args)
+            : value(std::make_obj_using_allocator<T>(
+                  alloc, std::forward<Args>(args)...)),
+              next(nullptr) {}
+    };
+
+    using Allocator = std::pmr::polymorphic_allocator<Node>;
+
+    // Слот читателя: 0 - не читает, иначе эпоха, в которой начал чтение
+    struct alignas(64) ReaderSlot {
+        std::atomic<uint64_t> epoch{0};
+        std::atomic<bool> in_use{false};
+    };
+
+    // Удалённый узел и эпоха, в которой он был отцеплен
+    struct Retired {
+        Node* node;
+        uint64_t epoch;
+    };
+
+    static constexpr size_t kMaxReaders = 128;
+    // После скольких удалений писатель пытается освободить память
+    static constexpr size_t kReclaimThreshold = 64;
+
+    std::atomic<Node*> head_;
+    Allocator allocator_;
+    // Пишет только писатель, но читать могут и читатели
+    std::atomic<size_t> size_;
+
+    std::atomic<uint64_t> global_epoch_;
+    // Слоты занимают и читатели, у которых есть только const-ссылка
+    mutable ReaderSlot slots_[kMaxReaders];
+    std::deque<Retired> retired_;
+
+    template <typename... Args>
+    Node* create_node(Args&&... args) {
+        Node* new_node = allocator_.allocate(1);
+        try {
+            allocator_.construct(new_node, std::forward<Args>(args)...);
+        } catch (...) {
+            allocator_.deallocate(new_node, 1);
+            throw;
+        }
+        return new_node;
+    }
+
+    void destroy_node(Node* node) {
+        std::allocator_traits<Allocator>::destroy(allocator_, node);
+        allocator_.deallocate(node, 1);
+    }
+
+    // Отложить освобождение отцепленного узла
+    void retire(Node* node) {
+        uint64_t epoch = global_epoch_.load(std::memory_order_relaxed);
+        retired_.push_back(Retired{node, epoch});
+        // Читатель, увидевший новую эпоху, увидит и отцепление узла
+        global_epoch_.store(epoch + 1, std::memory_order_release);
+        size_.store(size_.load(std::memory_order_relaxed) - 1,
+                    std::memory_order_relaxed);
+        if (retired_.size() >= kReclaimThreshold) {
+            try_reclaim();
+        }
+    }
+
+   public:
+    // Константный итератор для обхода внутри ReadGuard (или писателем)
+    class Iterator {
+       private:
+        const Node* current_;
+
+       public:
+        using iterator_category = std::forward_iterator_tag;
+        using value_type = T;
+        using difference_type = std::ptrdiff_t;
+        using pointer = const T*;
+        using reference = const T&;
+
+        Iterator() : current_(nullptr) {}
+
+        explicit Iterator(const Node* node) : current_(node) {}
+
+        reference operator*() const { return current_->value; }
+
+        pointer operator->() const { return &current_->value; }
+
+        Iterator& operator++() {
+            current_ = current_->next.load(std::memory_order_acquire);
+            return *this;
+        }
+
+        Iterator operator++(int) {
+            Iterator tmp = *this;
+            ++(*this);
+            return tmp;
+        }
+
+        bool operator==(const Iterator& other) const {
+            return current_ == other.current_;
+        }
+
+        bool operator!=(const Iterator& other) const {
+            return !(*this == other);
+        }
+
+       private:
+        friend class RcuForwardList;
+    };
+
+    // Критическая секция чтения: пока объект жив, узлы, видимые через
+    // begin()/end(), не будут освобождены
+    class ReadGuard {
+       private:
+        const RcuForwardList* list_;
+        ReaderSlot* slot_;
+
+       public:
+        ReadGuard(const RcuForwardList* list, ReaderSlot* slot)
+            : list_(list), slot_(slot) {
+            uint64_t epoch =
+                list_->global_epoch_.load(std::memory_order_acquire);
+            slot_->epoch.store(epoch, std::memory_order_relaxed);
+            // Запись слота должна стать видна писателю раньше чтения head_
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+        }
+
+        ~ReadGuard() { slot_->epoch.store(0, std::memory_order_release); }
+
+        ReadGuard(const ReadGuard&) = delete;
+        ReadGuard& operator=(const ReadGuard&) = delete;
+
+        Iterator begin() const {
+            return Iterator(list_->head_.load(std::memory_order_acquire));
+        }
+
+        Iterator end() const { return Iterator(nullptr); }
+    };
+
+    // Зарегистрированный читатель: владеет слотом, пока жив.
+    // Один Reader используется одним потоком, секции чтения не вкладываются.
+    class Reader {
+       private:
+        const RcuForwardList* list_;
+        ReaderSlot* slot_;
+
+       public:
+        Reader(const RcuForwardList* list, ReaderSlot* slot)
+            : list_(list), slot_(slot) {}
+
+        ~Reader() {
+            if (slot_ != nullptr) {
+                slot_->in_use.store(false, std::memory_order_release);
+            }
+        }
+
+        Reader(Reader&& other) noexcept
+            : list_(other.list_), slot_(other.slot_) {
+            other.slot_ = nullptr;
+        }
+
+        Reader(const Reader&) = delete;
+        Reader& operator=(const Reader&) = delete;
+        Reader& operator=(Reader&&) = delete;
+
+        ReadGuard read() const { return ReadGuard(list_, slot_); }
+    };
+
+    explicit RcuForwardList(
+        std::pmr::memory_resource* mr = std::pmr::get_default_resource())
+        : head_(nullptr), allocator_(mr), size_(0), global_epoch_(1) {}
+
+    // Деструктор: к этому моменту читателей быть не должно
+    ~RcuForwardList() {
+        Node* node = head_.load(std::memory_order_relaxed);
+        while (node != nullptr) {
+            Node* next = node->next.load(std::memory_order_relaxed);
+            destroy_node(node);
+            node = next;
+        }
+        for (const Retired& retired : retired_) {
+            destroy_node(retired.node);
+        }
+    }
+
+    // Запрет копирования
+    RcuForwardList(const RcuForwardList&) = delete;
+    RcuForwardList& operator=(const RcuForwardList&) = delete;
+
+    // Занять слот читателя (единственная RMW-операция на стороне читателя,
+    // выполняется один раз при регистрации потока)
+    Reader register_reader() const {
+        for (ReaderSlot& slot : slots_) {
+            bool expected = false;
+            if (slot.in_use.compare_exchange_strong(
+                    expected, true, std::memory_order_acquire)) {
+                return Reader(this, &slot);
+            }
+        }
+        throw std::runtime_error("Слишком много читателей");
+    }
+
+    // Добавить элемент в начало (только писатель)
+    void push_front(const T& value) { emplace_front(value); }
+
+    template <typename... Args>
+    void emplace_front(Args&&... args) {
+        Node* new_node = create_node(std::forward<Args>(args)...);
+        new_node->next.store(head_.load(std::memory_order_relaxed),
+                             std::memory_order_relaxed);
+        head_.store(new_node, std::memory_order_release);
+        size_.store(size_.load(std::memory_order_relaxed) + 1,
+                    std::memory_order_relaxed);
+    }
+
+    // Удалить первый элемент (только писатель)
+    void pop_front() {
+        Node* old_head = head_.load(std::memory_order_relaxed);
+        if (old_head == nullptr) {
+            throw std::runtime_error("Список пуст");
+        }
+        head_.store(old_head->next.load(std::memory_order_relaxed),
+                    std::memory_order_release);
+        retire(old_head);
+    }
+
+    // Удалить элемент после pos (только писатель). pos получен через
+    // writer_begin(); возвращает false, если после pos ничего нет.
+    bool erase_after(Iterator pos) {
+        Node* prev = const_cast<Node*>(pos.current_);
+        if (prev == nullptr) {
+            throw std::out_of_range("Недопустимый итератор");
+        }
+        Node* victim = prev->next.load(std::memory_order_relaxed);
+        if (victim == nullptr) {
+            return false;
+        }
+        prev->next.store(victim->next.load(std::memory_order_relaxed),
+                         std::memory_order_release);
+        retire(victim);
+        return true;
+    }
+
+    // Освободить удалённые узлы, которые уже не может видеть ни один
+    // читатель. Возвращает число освобождённых узлов (только писатель).
+    size_t try_reclaim() {
+        // Парный барьер к барьеру в ReadGuard
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        uint64_t oldest_active = UINT64_MAX;
+        for (const ReaderSlot& slot : slots_) {
+            uint64_t epoch = slot.epoch.load(std::memory_order_acquire);
+            if (epoch != 0 && epoch < oldest_active) {
+                oldest_active = epoch;
+            }
+        }
+
+        // Узел, отцепленный в эпоху E, видят только читатели с эпохой <= E
+        size_t freed = 0;
+        while (!retired_.empty() && retired_.front().epoch < oldest_active) {
+            destroy_node(retired_.front().node);
+            retired_.pop_front();
+            ++freed;
+        }
+        return freed;
+    }
+
+    // Число узлов, ожидающих освобождения
+    size_t retired_count() const { return retired_.size(); }
+
+    // Обход со стороны писателя: без ReadGuard, т.к. освобождает только он
+    Iterator writer_begin() const {
+        return Iterator(head_.load(std::memory_order_relaxed));
+    }
+
+    Iterator writer_end() const { return Iterator(nullptr); }
+
+    // Число элементов; из потока читателя - приблизительное значение,
+    // не согласованное с обходом в ReadGuard
+    size_t size() const { return size_.load(std::memory_order_relaxed); }
+
+    bool empty() const {
+        return head_.load(std::memory_order_relaxed) == nullptr;
+    }
+};
+
+#endif
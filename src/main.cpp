@@ -3,6 +3,7 @@
 
 #include "FixedBlockMapResource.h"
 #include "ForwardList.h"
+#include "PmrPerson.h"
 
 
 // Простая структура для демонстрации работы со сложными типами
@@ -108,5 +109,21 @@ int main() {
         std::cout << "\n";
     }
 
+    // ТЕСТ 5: Вложенные pmr-данные в том же resource
+    {
+        FixedBlockMapResource resource(4096);
+        ForwardList<PmrPerson> people(&resource);
+
+        people.emplace_back(1, "Alice with a name longer than SSO buffer");
+        people.emplace_back(2, "Bob");
+
+        std::cout << "\nPmr-люди:\n";
+        for (auto& person : people) {
+            std::cout << person.id << ": " << person.name << " (в буфере: "
+                      << (resource.owns(person.name.data()) ? "да" : "нет")
+                      << ")\n";
+        }
+    }
+
     return 0;
 }